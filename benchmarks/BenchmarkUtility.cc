@@ -0,0 +1,172 @@
+/*
+ * File: BenchmarkUtility.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "BenchmarkUtility.h"
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+#include "Allocator.h"
+#include "BufferClient.h"
+#include "PacketBuffer.h"
+#include "packets/PacketUtility.h"
+#include "properties/StringPairProperty.h"
+
+using namespace CppMqtt;
+
+static std::atomic<uint64_t> allocations(0);
+
+/**
+ * @brief Forwards library allocations to malloc while counting them
+ */
+class CountingAllocator : public MallocAllocator
+{
+public:
+    void *allocate(size_t size) override
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return MallocAllocator::allocate(size);
+    }
+};
+
+// Installed before any benchmark runs and kept for the whole run
+static CountingAllocator countingAllocator;
+static Allocator *mallocAllocator = setDefaultAllocator(&countingAllocator);
+
+void *operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *pointer = malloc(size ? size : 1);
+
+    if (pointer == NULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+uint64_t CppMqtt::allocationCount()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+AllocationScope::AllocationScope() : start(allocationCount())
+{
+}
+
+uint64_t AllocationScope::count()
+{
+    return allocationCount() - start;
+}
+
+void CppMqtt::report(benchmark::State &state, size_t bytes, uint64_t allocations)
+{
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["allocs/op"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+}
+
+std::vector<uint8_t> CppMqtt::serialize(Packet &packet)
+{
+    PacketBuffer buffer(packet.totalSize());
+    packet.push(buffer);
+    return std::vector<uint8_t>(buffer.getBuffer(), buffer.getBuffer() + buffer.getLength());
+}
+
+void CppMqtt::addUserProperties(Properties &properties, int64_t count)
+{
+    for (int64_t i = 0; i < count; i++)
+    {
+        properties.addProperty(new StringPairProperty(USER_PROPERTY, EncodedString("key", 3), EncodedString("value", 5)));
+    }
+}
+
+std::vector<char> CppMqtt::makeTopic(size_t length)
+{
+    std::vector<char> topic(length, 'a');
+
+    // Split the topic into levels of 8 characters
+    for (size_t i = 8; i < length; i += 8)
+    {
+        topic[i] = '/';
+    }
+
+    return topic;
+}
+
+void CppMqtt::encodePacket(benchmark::State &state, Packet &packet)
+{
+    size_t bytes = packet.totalSize();
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        PacketBuffer buffer(packet.totalSize());
+        packet.push(buffer);
+        benchmark::DoNotOptimize(buffer.getBuffer());
+        benchmark::ClobberMemory();
+    }
+
+    report(state, bytes, scope.count());
+}
+
+void CppMqtt::decodePacket(benchmark::State &state, const std::vector<uint8_t> &bytes)
+{
+    PacketPool pool;
+
+    // Warm the pool so reused buffers are measured, as on a long running connection
+    {
+        BufferClient client(bytes.data(), bytes.size());
+        pool.release(readPacketFromClient(&client, pool));
+    }
+
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        BufferClient client(bytes.data(), bytes.size());
+        Packet *packet = readPacketFromClient(&client, pool);
+        benchmark::DoNotOptimize(packet);
+        pool.release(packet);
+    }
+
+    report(state, bytes.size(), scope.count());
+}
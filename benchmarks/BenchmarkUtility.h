@@ -0,0 +1,116 @@
+/*
+ * File: BenchmarkUtility.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef BENCHMARKS_BENCHMARKUTILITY
+#define BENCHMARKS_BENCHMARKUTILITY
+
+#include <stdint.h>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "packets/Packet.h"
+#include "MqttProperties.h"
+
+namespace CppMqtt
+{
+    /**
+     * @brief Counts heap allocations made between construction and count
+     * Includes allocations made through the library Allocator and through operator new
+     */
+    class AllocationScope
+    {
+    private:
+        uint64_t start;
+
+    public:
+        AllocationScope();
+        uint64_t count();
+    };
+
+    /**
+     * @brief Returns the amount of heap allocations made since the benchmarks started
+     *
+     * @return uint64_t
+     */
+    uint64_t allocationCount();
+
+    /**
+     * @brief Reports bytes/s and allocs/op for a finished benchmark loop
+     *
+     * @param state
+     * @param bytes The amount of bytes handled per iteration
+     * @param allocations The amount of allocations made over all iterations
+     */
+    void report(benchmark::State &state, size_t bytes, uint64_t allocations);
+
+    /**
+     * @brief Encodes a packet into a vector, including the fixed header
+     *
+     * @param packet
+     * @return std::vector<uint8_t>
+     */
+    std::vector<uint8_t> serialize(Packet &packet);
+
+    /**
+     * @brief Adds a number of user properties to a property block
+     *
+     * @param properties
+     * @param count
+     */
+    void addUserProperties(Properties &properties, int64_t count);
+
+    /**
+     * @brief Returns a topic made up of levels of the given total length
+     *
+     * @param length
+     * @return std::vector<char>
+     */
+    std::vector<char> makeTopic(size_t length);
+
+    /**
+     * @brief Repeatedly encodes a packet into a buffer sized for it
+     *
+     * @param state
+     * @param packet
+     */
+    void encodePacket(benchmark::State &state, Packet &packet);
+
+    /**
+     * @brief Repeatedly decodes an encoded packet through an in memory client
+     * Uses a PacketPool the same way the client receive path does
+     *
+     * @param state
+     * @param bytes
+     */
+    void decodePacket(benchmark::State &state, const std::vector<uint8_t> &bytes);
+}
+
+#endif /* BENCHMARKS_BENCHMARKUTILITY */
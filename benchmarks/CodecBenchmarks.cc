@@ -0,0 +1,229 @@
+/*
+ * File: CodecBenchmarks.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "BenchmarkUtility.h"
+#include "BufferClient.h"
+#include "PacketBuffer.h"
+#include "packets/PacketTemplates.h"
+#include "packets/PacketUtility.h"
+#include "types/VariableByteInteger.h"
+#include "utils/Utf8.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+/* Control packet templates against constructing and pushing the packet */
+
+static void BM_PublishAcknowledgeTemplate(benchmark::State &state)
+{
+    uint16_t identifier = 0;
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        PacketTemplate<4> packet = withPacketIdentifier(PUBLISH_ACKNOWLEDGE_TEMPLATE, ++identifier);
+        benchmark::DoNotOptimize(packet.bytes);
+    }
+
+    report(state, PUBLISH_ACKNOWLEDGE_TEMPLATE.size(), scope.count());
+}
+BENCHMARK(BM_PublishAcknowledgeTemplate);
+
+static void BM_PublishAcknowledgePacket(benchmark::State &state)
+{
+    uint16_t identifier = 0;
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        PublishAcknowledge packet;
+        packet.setPacketIdentifier(++identifier);
+        PacketBuffer buffer(packet.totalSize());
+        packet.push(buffer);
+        benchmark::DoNotOptimize(buffer.getBuffer());
+        benchmark::ClobberMemory();
+    }
+
+    report(state, PUBLISH_ACKNOWLEDGE_TEMPLATE.size(), scope.count());
+}
+BENCHMARK(BM_PublishAcknowledgePacket);
+
+static void BM_PingRequestTemplate(benchmark::State &state)
+{
+    uint8_t output[PING_REQUEST_TEMPLATE.size()];
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        memcpy(output, PING_REQUEST_TEMPLATE.bytes, PING_REQUEST_TEMPLATE.size());
+        benchmark::DoNotOptimize(output);
+        benchmark::ClobberMemory();
+    }
+
+    report(state, PING_REQUEST_TEMPLATE.size(), scope.count());
+}
+BENCHMARK(BM_PingRequestTemplate);
+
+static void BM_PingRequestPacket(benchmark::State &state)
+{
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        PingRequest packet;
+        PacketBuffer buffer(packet.totalSize());
+        packet.push(buffer);
+        benchmark::DoNotOptimize(buffer.getBuffer());
+        benchmark::ClobberMemory();
+    }
+
+    report(state, PING_REQUEST_TEMPLATE.size(), scope.count());
+}
+BENCHMARK(BM_PingRequestPacket);
+
+/* Variable Byte Integer */
+
+// Largest value encoded in each of the 1 to 4 byte encodings
+static const uint32_t VARIABLE_BYTE_VALUES[] = {127, 16383, 2097151, 268435455};
+
+static void BM_VariableByteIntegerEncode(benchmark::State &state)
+{
+    uint32_t value = VARIABLE_BYTE_VALUES[state.range(0) - 1];
+    uint8_t output[4];
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(value);
+        benchmark::DoNotOptimize(VariableByteInteger::encode(value, output));
+        benchmark::ClobberMemory();
+    }
+
+    report(state, state.range(0), scope.count());
+}
+BENCHMARK(BM_VariableByteIntegerEncode)->DenseRange(1, 4);
+
+static void BM_VariableByteIntegerPush(benchmark::State &state)
+{
+    VariableByteInteger value(VARIABLE_BYTE_VALUES[state.range(0) - 1]);
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        // Includes the PacketBuffer, as the send path needs one to push into
+        PacketBuffer output(4);
+        benchmark::DoNotOptimize(value.push(output));
+        benchmark::ClobberMemory();
+    }
+
+    report(state, state.range(0), scope.count());
+}
+BENCHMARK(BM_VariableByteIntegerPush)->DenseRange(1, 4);
+
+static void BM_VariableByteIntegerDecode(benchmark::State &state)
+{
+    uint8_t input[4];
+    size_t length = VariableByteInteger::encode(VARIABLE_BYTE_VALUES[state.range(0) - 1], input);
+    uint32_t value;
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(input);
+        benchmark::DoNotOptimize(VariableByteInteger::decode(input, length, value));
+        benchmark::DoNotOptimize(value);
+    }
+
+    report(state, length, scope.count());
+}
+BENCHMARK(BM_VariableByteIntegerDecode)->DenseRange(1, 4);
+
+static void BM_VariableByteIntegerReadFromClient(benchmark::State &state)
+{
+    uint8_t input[4];
+    size_t length = VariableByteInteger::encode(VARIABLE_BYTE_VALUES[state.range(0) - 1], input);
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        BufferClient client(input, length);
+        VariableByteInteger value;
+        uint32_t read = 0;
+        value.readFromClient(&client, read);
+        benchmark::DoNotOptimize(value.value);
+    }
+
+    report(state, length, scope.count());
+}
+BENCHMARK(BM_VariableByteIntegerReadFromClient)->DenseRange(1, 4);
+
+/* UTF-8 validation */
+
+static void BM_Utf8Ascii(benchmark::State &state)
+{
+    vector<uint8_t> text(state.range(0), 'a');
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(isValidUtf8(text.data(), text.size()));
+    }
+
+    report(state, text.size(), scope.count());
+}
+BENCHMARK(BM_Utf8Ascii)->RangeMultiplier(8)->Range(8, 32768);
+
+static void BM_Utf8MultiByte(benchmark::State &state)
+{
+    // Mix of two, three and four byte characters
+    const uint8_t characters[] = {0xC3, 0xA9, 0xE2, 0x82, 0xAC, 0xF0, 0x9F, 0x98, 0x80};
+    vector<uint8_t> text;
+
+    while (text.size() + sizeof(characters) <= (size_t)state.range(0))
+    {
+        text.insert(text.end(), characters, characters + sizeof(characters));
+    }
+
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(isValidUtf8(text.data(), text.size()));
+    }
+
+    report(state, text.size(), scope.count());
+}
+BENCHMARK(BM_Utf8MultiByte)->RangeMultiplier(8)->Range(64, 32768);
@@ -0,0 +1,174 @@
+/*
+ * File: LoopbackBenchmarks.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "BenchmarkUtility.h"
+#include "LoopbackBroker.h"
+#include "SocketClient.h"
+#include "MqttClient.h"
+
+using namespace std;
+using namespace CppMqtt;
+using SteadyClock = std::chrono::steady_clock;
+
+#define TOKEN_COUNT 65536
+#define LATENCY_SAMPLES_MAXIMUM (1 << 20)
+
+/**
+ * @brief Tracks outstanding publishes and their publish to acknowledge latency
+ */
+class ThroughputHandler : public MqttClientHandlerV2
+{
+public:
+    SteadyClock::time_point sent[TOKEN_COUNT];
+    vector<uint64_t> latencies;
+    uint32_t inflight = 0;
+    uint64_t failures = 0;
+    bool connected = false;
+
+    ThroughputHandler() { latencies.reserve(LATENCY_SAMPLES_MAXIMUM); }
+
+    void onConnectionSuccess() override { connected = true; }
+    void onConnectionFailure(int) override {}
+    void onDisconnection(ReasonCode) override { connected = false; }
+    void onMessage(string_view, span<const uint8_t>, const MessageMetadata &) override {}
+    void onSubscribeResult(Token, span<const uint8_t>) override {}
+    void onUnsubscribeResult(Token, span<const uint8_t>) override {}
+
+    void onDeliveryComplete(Token token) override
+    {
+        if (latencies.size() < LATENCY_SAMPLES_MAXIMUM)
+        {
+            latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - sent[token]).count());
+        }
+        inflight--;
+    }
+
+    void onDeliveryFailure(Token, int) override
+    {
+        failures++;
+        inflight--;
+    }
+};
+
+/**
+ * @brief Returns a percentile of the recorded latencies in microseconds
+ *
+ * @param latencies Reordered in place
+ * @param percentile Between 0 and 1
+ * @return double
+ */
+static double percentile(vector<uint64_t> &latencies, double percentile)
+{
+    if (latencies.empty())
+    {
+        return 0;
+    }
+
+    size_t index = std::min(latencies.size() - 1, (size_t)(percentile * latencies.size()));
+    std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+    return latencies[index] / 1000.0;
+}
+
+/**
+ * @brief Publishes through a full MqttClient to a broker stand-in over a socket pair
+ * Arguments are the QoS, the payload size and the maximum amount of unacknowledged publishes
+ *
+ * @param state
+ */
+static void BM_LoopbackPublish(benchmark::State &state)
+{
+    QoS qos = QoS::_from_integral(state.range(0));
+    vector<uint8_t> data(state.range(1), 'p');
+    uint32_t depth = state.range(2);
+
+    LoopbackBroker broker;
+    SocketClient client(broker.clientSocket());
+    MqttClient mqttClient((Client *)&client);
+    ThroughputHandler *handler = new ThroughputHandler();
+
+    mqttClient.setHandler((MqttClientHandlerV2 *)handler);
+    mqttClient.connect("loopback", 0, 1000);
+
+    while (!handler->connected && client.connected())
+    {
+        mqttClient.sync();
+    }
+
+    if (!handler->connected)
+    {
+        state.SkipWithError("Failed to connect to the loopback broker");
+        delete handler;
+        return;
+    }
+
+    EncodedString topic("benchmarks/loopback", 19);
+    Payload payload = Payload::wrap(data.data(), data.size());
+
+    for (auto _ : state)
+    {
+        while (handler->inflight >= depth)
+        {
+            mqttClient.sync();
+        }
+
+        SteadyClock::time_point now = SteadyClock::now();
+        Token token = mqttClient.publish(topic, payload, qos);
+        handler->sent[token] = now;
+        handler->inflight++;
+    }
+
+    // Every publish must be acknowledged for the run to count
+    while (handler->inflight > 0 && client.connected())
+    {
+        mqttClient.sync();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * data.size());
+    state.counters["p50_us"] = percentile(handler->latencies, 0.5);
+    state.counters["p99_us"] = percentile(handler->latencies, 0.99);
+    state.counters["p999_us"] = percentile(handler->latencies, 0.999);
+    state.counters["failures"] = handler->failures;
+
+    mqttClient.disconnect(ReasonCode::NORMAL_DISCONNECTION);
+    delete handler;
+}
+BENCHMARK(BM_LoopbackPublish)
+    ->ArgNames({"qos", "payload", "inflight"})
+    ->ArgsProduct({{0, 1, 2}, {16, 256, 4096, 65536}, {1, 16, 64}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
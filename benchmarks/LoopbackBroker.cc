@@ -0,0 +1,88 @@
+/*
+ * File: LoopbackBroker.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "LoopbackBroker.h"
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include "SocketClient.h"
+
+using namespace CppMqtt;
+
+#define BROKER_POLL_TIMEOUT 100
+
+LoopbackBroker::LoopbackBroker() : publishes(0)
+{
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0)
+    {
+        thread = std::thread(&LoopbackBroker::run, this);
+    }
+}
+
+LoopbackBroker::~LoopbackBroker()
+{
+    if (sockets[0] >= 0)
+    {
+        ::shutdown(sockets[0], SHUT_RDWR);
+    }
+
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+
+    for (int socket : sockets)
+    {
+        if (socket >= 0)
+        {
+            ::close(socket);
+        }
+    }
+}
+
+void LoopbackBroker::run()
+{
+    Broker broker;
+    SocketClient client(sockets[1]);
+
+    broker.attach(&client);
+
+    // The session is removed once the client disconnects or the socket closes
+    while (broker.sessionCount() > 0)
+    {
+        struct pollfd descriptor = {client.getFileDescriptor(), POLLIN, 0};
+        ::poll(&descriptor, 1, BROKER_POLL_TIMEOUT);
+
+        broker.sync();
+        publishes.store(broker.publishesReceived(), std::memory_order_relaxed);
+    }
+}
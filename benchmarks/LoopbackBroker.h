@@ -0,0 +1,77 @@
+/*
+ * File: LoopbackBroker.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef BENCHMARKS_LOOPBACKBROKER
+#define BENCHMARKS_LOOPBACKBROKER
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <thread>
+#include "Broker.h"
+
+namespace CppMqtt
+{
+    /**
+     * @brief A Broker on the far end of a socket pair, served from its own thread
+     */
+    class LoopbackBroker
+    {
+    private:
+        int sockets[2] = {-1, -1};
+        std::thread thread;
+        std::atomic<uint64_t> publishes;
+
+        void run();
+
+    public:
+        LoopbackBroker();
+        LoopbackBroker(const LoopbackBroker &) = delete;
+        LoopbackBroker &operator=(const LoopbackBroker &) = delete;
+        ~LoopbackBroker();
+
+        /**
+         * @brief Returns the socket a client should use to talk to the broker
+         *
+         * @return int The socket, -1 if the socket pair could not be created
+         */
+        int clientSocket() { return sockets[0]; };
+        /**
+         * @brief Returns the amount of publish packets received
+         *
+         * @return uint64_t
+         */
+        uint64_t received() { return publishes.load(std::memory_order_relaxed); };
+    };
+}
+
+#endif /* BENCHMARKS_LOOPBACKBROKER */
@@ -0,0 +1,309 @@
+/*
+ * File: PacketBenchmarks.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include <stdint.h>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "BenchmarkUtility.h"
+#include "PacketBuffer.h"
+#include "packets/PacketUtility.h"
+#include "types/SubscribePayload.h"
+#include "types/UnsubscribePayload.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+#define PAYLOAD_SIZES {0, 64, 1024, 16384}
+#define PROPERTY_COUNTS {0, 4, 16}
+#define TOPIC_LENGTHS {8, 64, 256}
+#define TOPIC_COUNTS {1, 8, 32}
+
+/**
+ * @brief Encodes a property block, including its length
+ *
+ * @param count The amount of user properties in the block
+ * @return vector<uint8_t>
+ */
+static vector<uint8_t> propertyBlock(int64_t count)
+{
+    Properties properties;
+    addUserProperties(properties, count);
+
+    PacketBuffer buffer(properties.totalSize());
+    properties.push(buffer);
+    return vector<uint8_t>(buffer.getBuffer(), buffer.getBuffer() + buffer.getLength());
+}
+
+/**
+ * @brief Prefixes the contents of a packet with its fixed header
+ *
+ * @param fixedHeader
+ * @param contents
+ * @return vector<uint8_t>
+ */
+static vector<uint8_t> withFixedHeader(uint8_t fixedHeader, const vector<uint8_t> &contents)
+{
+    vector<uint8_t> bytes(1, fixedHeader);
+    uint8_t length[4];
+    bytes.insert(bytes.end(), length, length + VariableByteInteger::encode(contents.size(), length));
+    bytes.insert(bytes.end(), contents.begin(), contents.end());
+    return bytes;
+}
+
+static void createPublish(Publish &packet, benchmark::State &state)
+{
+    vector<char> topic = makeTopic(state.range(2));
+    vector<uint8_t> payload(state.range(0), 'p');
+
+    packet.setQos(QoS::ONE);
+    packet.setPacketIdentifier(1);
+    packet.setTopic(topic.data(), topic.size());
+    packet.setPayload(payload.data(), payload.size());
+    addUserProperties(packet.getProperties(), state.range(1));
+}
+
+static void createSubscription(Subscription &packet, vector<SubscriptionPayload *> &payloads, benchmark::State &state)
+{
+    vector<char> topic = makeTopic(state.range(1));
+
+    packet.setPacketIdentifier(1);
+
+    for (auto payload : payloads)
+    {
+        payload->setTopic(topic.data(), topic.size());
+        packet.addPayload(payload);
+    }
+
+    addUserProperties(packet.getProperties(), state.range(2));
+}
+
+/* Connect */
+
+static void BM_ConnectEncode(benchmark::State &state)
+{
+    Connect packet;
+    vector<char> identifier = makeTopic(23);
+
+    packet.setClientId(identifier.data(), identifier.size());
+    packet.setKeepAliveInterval(60);
+    addUserProperties(packet.getProperties(), state.range(0));
+
+    encodePacket(state, packet);
+}
+BENCHMARK(BM_ConnectEncode)->ArgsProduct({PROPERTY_COUNTS});
+
+static void BM_ConnectAcknowledgeDecode(benchmark::State &state)
+{
+    vector<uint8_t> contents = {
+        0x00, // Acknowledge flags
+        0x00  // Reason code
+    };
+    vector<uint8_t> properties = propertyBlock(state.range(0));
+    contents.insert(contents.end(), properties.begin(), properties.end());
+
+    decodePacket(state, withFixedHeader(PacketId::CONNECT_ACKNOWLEDGE, contents));
+}
+BENCHMARK(BM_ConnectAcknowledgeDecode)->ArgsProduct({PROPERTY_COUNTS});
+
+/* Publish */
+
+static void BM_PublishEncode(benchmark::State &state)
+{
+    Publish packet;
+    createPublish(packet, state);
+    encodePacket(state, packet);
+}
+BENCHMARK(BM_PublishEncode)->ArgsProduct({PAYLOAD_SIZES, PROPERTY_COUNTS, TOPIC_LENGTHS});
+
+static void BM_PublishDecode(benchmark::State &state)
+{
+    Publish packet;
+    createPublish(packet, state);
+    decodePacket(state, serialize(packet));
+}
+BENCHMARK(BM_PublishDecode)->ArgsProduct({PAYLOAD_SIZES, PROPERTY_COUNTS, TOPIC_LENGTHS});
+
+static void BM_PreparedPublishEncode(benchmark::State &state)
+{
+    vector<char> topic = makeTopic(state.range(2));
+    vector<uint8_t> data(state.range(0), 'p');
+    EncodedString topicString(topic.data(), topic.size());
+    Properties properties;
+    addUserProperties(properties, state.range(1));
+
+    PreparedPublish prepared(topicString, QoS::ONE, false, &properties);
+    Payload payload = Payload::wrap(data.data(), data.size());
+    size_t bytes = prepared.totalSize(payload);
+    AllocationScope scope;
+
+    for (auto _ : state)
+    {
+        PacketBuffer buffer(prepared.totalSize(payload));
+        prepared.push(buffer, 1, payload);
+        benchmark::DoNotOptimize(buffer.getBuffer());
+        benchmark::ClobberMemory();
+    }
+
+    report(state, bytes, scope.count());
+}
+BENCHMARK(BM_PreparedPublishEncode)->ArgsProduct({PAYLOAD_SIZES, PROPERTY_COUNTS, TOPIC_LENGTHS});
+
+/* Publish acknowledgements */
+
+template <typename T>
+static void BM_AcknowledgeEncode(benchmark::State &state)
+{
+    T packet;
+    packet.setPacketIdentifier(1);
+    packet.setReasonCode(state.range(0) > 0 ? ReasonCode::UNSPECIFIED_ERROR : ReasonCode::SUCCESS);
+    addUserProperties(packet.getProperties(), state.range(0));
+    encodePacket(state, packet);
+}
+BENCHMARK_TEMPLATE(BM_AcknowledgeEncode, PublishAcknowledge)->ArgsProduct({PROPERTY_COUNTS});
+BENCHMARK_TEMPLATE(BM_AcknowledgeEncode, PublishReceived)->ArgsProduct({PROPERTY_COUNTS});
+BENCHMARK_TEMPLATE(BM_AcknowledgeEncode, PublishRelease)->ArgsProduct({PROPERTY_COUNTS});
+BENCHMARK_TEMPLATE(BM_AcknowledgeEncode, PublishComplete)->ArgsProduct({PROPERTY_COUNTS});
+
+template <typename T>
+static void BM_AcknowledgeDecode(benchmark::State &state)
+{
+    T packet;
+    packet.setPacketIdentifier(1);
+    packet.setReasonCode(state.range(0) > 0 ? ReasonCode::UNSPECIFIED_ERROR : ReasonCode::SUCCESS);
+    addUserProperties(packet.getProperties(), state.range(0));
+    decodePacket(state, serialize(packet));
+}
+BENCHMARK_TEMPLATE(BM_AcknowledgeDecode, PublishAcknowledge)->ArgsProduct({PROPERTY_COUNTS});
+BENCHMARK_TEMPLATE(BM_AcknowledgeDecode, PublishReceived)->ArgsProduct({PROPERTY_COUNTS});
+BENCHMARK_TEMPLATE(BM_AcknowledgeDecode, PublishRelease)->ArgsProduct({PROPERTY_COUNTS});
+BENCHMARK_TEMPLATE(BM_AcknowledgeDecode, PublishComplete)->ArgsProduct({PROPERTY_COUNTS});
+
+/* Subscribe and Unsubscribe */
+
+static void BM_SubscribeEncode(benchmark::State &state)
+{
+    Subscribe packet;
+    vector<SubscribePayload> payloads(state.range(0));
+    vector<SubscriptionPayload *> pointers;
+
+    for (auto &payload : payloads)
+    {
+        payload.setMaximumQos(QoS::ONE);
+        pointers.push_back(&payload);
+    }
+
+    createSubscription(packet, pointers, state);
+    encodePacket(state, packet);
+}
+BENCHMARK(BM_SubscribeEncode)->ArgsProduct({TOPIC_COUNTS, TOPIC_LENGTHS, PROPERTY_COUNTS});
+
+static void BM_SubscribeAcknowledgeDecode(benchmark::State &state)
+{
+    vector<uint8_t> contents = {0x01, 0x00}; // Packet Identifier
+    vector<uint8_t> properties = propertyBlock(state.range(1));
+    contents.insert(contents.end(), properties.begin(), properties.end());
+    contents.insert(contents.end(), state.range(0), 0x01); // Granted QoS 1
+
+    decodePacket(state, withFixedHeader(PacketId::SUBSCRIBE_ACKNOWLEDGE, contents));
+}
+BENCHMARK(BM_SubscribeAcknowledgeDecode)->ArgsProduct({TOPIC_COUNTS, PROPERTY_COUNTS});
+
+static void BM_UnsubscribeEncode(benchmark::State &state)
+{
+    Unsubscribe packet;
+    vector<UnsubscribePayload> payloads(state.range(0));
+    vector<SubscriptionPayload *> pointers;
+
+    for (auto &payload : payloads)
+    {
+        pointers.push_back(&payload);
+    }
+
+    createSubscription(packet, pointers, state);
+    encodePacket(state, packet);
+}
+BENCHMARK(BM_UnsubscribeEncode)->ArgsProduct({TOPIC_COUNTS, TOPIC_LENGTHS, PROPERTY_COUNTS});
+
+static void BM_UnsubscribeAcknowledgeDecode(benchmark::State &state)
+{
+    vector<uint8_t> contents = {0x01, 0x00}; // Packet Identifier
+    vector<uint8_t> properties = propertyBlock(state.range(1));
+    contents.insert(contents.end(), properties.begin(), properties.end());
+    contents.insert(contents.end(), state.range(0), 0x00); // Success
+
+    decodePacket(state, withFixedHeader(PacketId::UNSUBSCRIBE_ACKNOWLEDGE, contents));
+}
+BENCHMARK(BM_UnsubscribeAcknowledgeDecode)->ArgsProduct({TOPIC_COUNTS, PROPERTY_COUNTS});
+
+/* Ping */
+
+template <typename T>
+static void BM_PingEncode(benchmark::State &state)
+{
+    T packet;
+    encodePacket(state, packet);
+}
+BENCHMARK_TEMPLATE(BM_PingEncode, PingRequest);
+BENCHMARK_TEMPLATE(BM_PingEncode, PingResponse);
+
+template <typename T>
+static void BM_PingDecode(benchmark::State &state)
+{
+    T packet;
+    decodePacket(state, serialize(packet));
+}
+BENCHMARK_TEMPLATE(BM_PingDecode, PingRequest);
+BENCHMARK_TEMPLATE(BM_PingDecode, PingResponse);
+
+/* Disconnect and Authentication */
+
+template <typename T>
+static void BM_ReasonEncode(benchmark::State &state)
+{
+    // Both packets default to a success reason code
+    T packet;
+    addUserProperties(packet.getProperties(), state.range(0));
+    encodePacket(state, packet);
+}
+BENCHMARK_TEMPLATE(BM_ReasonEncode, Disconnect)->ArgsProduct({PROPERTY_COUNTS});
+BENCHMARK_TEMPLATE(BM_ReasonEncode, Authentication)->ArgsProduct({PROPERTY_COUNTS});
+
+template <typename T>
+static void BM_ReasonDecode(benchmark::State &state)
+{
+    // Both packets default to a success reason code
+    T packet;
+    addUserProperties(packet.getProperties(), state.range(0));
+    decodePacket(state, serialize(packet));
+}
+BENCHMARK_TEMPLATE(BM_ReasonDecode, Disconnect)->ArgsProduct({PROPERTY_COUNTS});
+BENCHMARK_TEMPLATE(BM_ReasonDecode, Authentication)->ArgsProduct({PROPERTY_COUNTS});
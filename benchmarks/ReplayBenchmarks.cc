@@ -0,0 +1,119 @@
+/*
+ * File: ReplayBenchmarks.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark/benchmark.h"
+#include "BenchmarkUtility.h"
+#include "MqttClient.h"
+#include "ReplayClient.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+/**
+ * @brief Counts received messages without copying them
+ */
+class ReplayHandler : public MqttClientHandlerV2
+{
+public:
+    uint64_t messages = 0;
+
+    void onConnectionSuccess() override {}
+    void onConnectionFailure(int) override {}
+    void onDisconnection(ReasonCode) override {}
+    void onDeliveryComplete(Token) override {}
+    void onDeliveryFailure(Token, int) override {}
+    void onMessage(string_view, span<const uint8_t>, const MessageMetadata &) override { messages++; }
+    void onSubscribeResult(Token, span<const uint8_t>) override {}
+    void onUnsubscribeResult(Token, span<const uint8_t>) override {}
+};
+
+/**
+ * @brief Plays a capture from a RecordingClient through a fresh MqttClient at full speed
+ * The capture is read from the file named by the MQTT_CAPTURE environment variable
+ */
+static void BM_ReplayCapture(benchmark::State &state, const char *path)
+{
+    FILE *input = fopen(path, "rb");
+    ReplayClient replay;
+
+    if (input == NULL || replay.load(input) != 0)
+    {
+        if (input != NULL)
+        {
+            fclose(input);
+        }
+
+        state.SkipWithError("MQTT_CAPTURE is not a readable capture");
+        return;
+    }
+
+    fclose(input);
+
+    uint64_t messages = 0;
+    AllocationScope allocations;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ReplayHandler handler;
+        MqttClient client((Client *)&replay);
+        client.setHandler((MqttClientHandlerV2 *)&handler);
+        replay.rewind();
+        client.connect("replay", 1883, 0);
+        state.ResumeTiming();
+
+        while (!replay.finished())
+        {
+            client.sync();
+        }
+
+        messages += handler.messages;
+    }
+
+    report(state, replay.getRecordedBytes(), allocations.count());
+    state.counters["messages/s"] = benchmark::Counter(messages, benchmark::Counter::kIsRate);
+}
+
+static bool registerReplay = []()
+{
+    const char *path = getenv("MQTT_CAPTURE");
+
+    if (path != NULL)
+    {
+        benchmark::RegisterBenchmark("BM_ReplayCapture", BM_ReplayCapture, path);
+    }
+
+    return path != NULL;
+}();
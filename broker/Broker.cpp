@@ -0,0 +1,611 @@
+/*
+ * File: Broker.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#include "Broker.h"
+#include <string.h>
+#include "BufferClient.h"
+#include "PacketBuffer.h"
+#include "packets/PacketUtility.h"
+#include "types/VariableByteInteger.h"
+#include "utils/Topic.h"
+
+using namespace CppMqtt;
+
+#define PROTOCOL_VERSION 5
+#define PACKET_IDENTIFIER_SIZE 2
+
+#define PUBLISH_QOS_FLAGS 0x6
+#define PUBLISH_QOS_SHIFT 1
+#define PUBLISH_DUPLICATE_FLAGS 0x8
+#define REQUIRED_FLAGS 0x2
+
+#define SUBSCRIPTION_QOS_FLAGS 0x3
+#define SUBSCRIPTION_NO_LOCAL_FLAGS 0x4
+#define SUBSCRIPTION_RETAIN_HANDLING_SHIFT 4
+#define SUBSCRIPTION_RETAIN_HANDLING_FLAGS 0x3
+
+#define SHARED_PREFIX "$share/"
+#define SHARED_PREFIX_LENGTH 7
+
+/**
+ * @brief Bounds checked reading of the fields of a packet
+ */
+class FieldReader
+{
+private:
+    const uint8_t *position;
+    const uint8_t *end;
+
+public:
+    FieldReader(const uint8_t *data, size_t length) : position(data), end(data + length){};
+
+    bool empty() { return position == end; };
+
+    bool readByte(uint8_t &value)
+    {
+        if (position == end)
+        {
+            return false;
+        }
+        value = *position++;
+        return true;
+    }
+
+    bool readWord(uint16_t &value)
+    {
+        if (end - position < 2)
+        {
+            return false;
+        }
+        value = (position[0] << 8) | position[1];
+        position += 2;
+        return true;
+    }
+
+    /**
+     * @brief Reads a packet identifier, kept in the byte order of the packet classes
+     */
+    bool readPacketIdentifier(uint16_t &value)
+    {
+        if (end - position < PACKET_IDENTIFIER_SIZE)
+        {
+            return false;
+        }
+        memcpy(&value, position, PACKET_IDENTIFIER_SIZE);
+        position += PACKET_IDENTIFIER_SIZE;
+        return true;
+    }
+
+    bool readString(const char *&value, uint16_t &length)
+    {
+        if (!readWord(length) || end - position < length)
+        {
+            return false;
+        }
+        value = (const char *)position;
+        position += length;
+        return true;
+    }
+
+    bool skipProperties()
+    {
+        uint32_t length;
+        size_t read = VariableByteInteger::decode(position, end - position, length);
+
+        if (read == 0 || (size_t)(end - position) < read + length)
+        {
+            return false;
+        }
+        position += read + length;
+        return true;
+    }
+};
+
+/**
+ * @brief Fills in a packet from a complete variable header and payload
+ *
+ * @return true If the packet was completely read
+ */
+static bool decode(Packet &packet, const uint8_t *data, size_t length)
+{
+    BufferClient client(data, length);
+    uint32_t read = 0;
+
+    packet.setRemainingLength(length);
+
+    return !packet.readFromClient(&client, read);
+}
+
+void Broker::attach(Client *client)
+{
+    sessions.push_back({client, {}, "", {}, 0, false, true});
+}
+
+void Broker::detach(Client *client)
+{
+    sessions.remove_if([client](BrokerSession &session)
+                       { return session.client == client; });
+}
+
+void Broker::sync()
+{
+    for (BrokerSession &session : sessions)
+    {
+        if (!session.open)
+        {
+            continue;
+        }
+
+        session.client->sync();
+
+        int available;
+
+        while ((available = session.client->available()) > 0)
+        {
+            size_t offset = session.input.size();
+            session.input.resize(offset + available);
+            session.input.resize(offset + session.client->read(session.input.data() + offset, available));
+        }
+
+        process(session);
+
+        if (!session.client->connected())
+        {
+            session.open = false;
+        }
+    }
+
+    sessions.remove_if([](BrokerSession &session)
+                       { return !session.open; });
+}
+
+void Broker::process(BrokerSession &session)
+{
+    std::vector<uint8_t> &input = session.input;
+    size_t start = 0;
+
+    while (session.open && input.size() - start >= 2)
+    {
+        uint32_t length;
+        size_t lengthSize = VariableByteInteger::decode(input.data() + start + 1, input.size() - start - 1, length);
+
+        if (lengthSize == 0 || input.size() - start < 1 + lengthSize + length)
+        {
+            break;
+        }
+
+        if (!handle(session, input[start], input.data() + start + 1 + lengthSize, length))
+        {
+            close(session);
+        }
+
+        start += 1 + lengthSize + length;
+    }
+
+    input.erase(input.begin(), input.begin() + start);
+}
+
+bool Broker::handle(BrokerSession &session, uint8_t fixedHeader, const uint8_t *data, size_t length)
+{
+    uint8_t type = fixedHeader & 0xF0;
+
+    if (!session.connected)
+    {
+        // The first packet must be a CONNECT
+        return type == PacketId::CONNECT && handleConnect(session, data, length);
+    }
+
+    switch (type)
+    {
+    case PacketId::PUBLISH:
+        return handlePublish(session, fixedHeader, data, length);
+    case PacketId::PUBLISH_RECEIVED:
+    {
+        PublishReceived received(fixedHeader);
+
+        if (!decode(received, data, length))
+        {
+            return false;
+        }
+
+        PublishRelease release;
+        release.setPacketIdentifier(received.getPacketIdentifier());
+        send(session, release);
+    }
+    break;
+    case PacketId::PUBLISH_RELEASE:
+    {
+        PublishRelease release(fixedHeader);
+
+        if (!decode(release, data, length))
+        {
+            return false;
+        }
+
+        PublishComplete complete;
+        complete.setPacketIdentifier(release.getPacketIdentifier());
+        send(session, complete);
+    }
+    break;
+    case PacketId::PUBLISH_ACKNOWLEDGE:
+    case PacketId::PUBLISH_COMPLETE:
+        // Outbound messages are not retransmitted, so there is nothing to clear
+        break;
+    case PacketId::SUBSCRIBE:
+        return (fixedHeader & 0xF) == REQUIRED_FLAGS && handleSubscribe(session, data, length);
+    case PacketId::UNSUBSCRIBE:
+        return (fixedHeader & 0xF) == REQUIRED_FLAGS && handleUnsubscribe(session, data, length);
+    case PacketId::PING_REQUEST:
+    {
+        PingResponse response;
+        send(session, response);
+    }
+    break;
+    case PacketId::DISCONNECT:
+        return false;
+    default:
+        // A second CONNECT or a packet only a server can send
+        return false;
+    }
+
+    return true;
+}
+
+bool Broker::handleConnect(BrokerSession &session, const uint8_t *data, size_t length)
+{
+    FieldReader reader(data, length);
+    const char *protocol;
+    uint16_t protocolLength;
+    uint8_t version;
+    uint8_t flags;
+    uint16_t keepAlive;
+    const char *clientId;
+    uint16_t clientIdLength;
+
+    if (!reader.readString(protocol, protocolLength) || !reader.readByte(version))
+    {
+        return false;
+    }
+
+    ConnectAcknowledge acknowledge;
+
+    if (protocolLength != 4 || memcmp(protocol, "MQTT", 4) != 0 || version != PROTOCOL_VERSION)
+    {
+        acknowledge.setReasonCode(ReasonCode::UNSUPPORTED_PROTOCOL_VERSION);
+        send(session, acknowledge);
+        return false;
+    }
+
+    if (!reader.readByte(flags) || !reader.readWord(keepAlive) || !reader.skipProperties() ||
+        !reader.readString(clientId, clientIdLength))
+    {
+        return false;
+    }
+
+    // The will, user name and password are accepted but not used
+
+    if (clientIdLength > 0)
+    {
+        session.clientId.assign(clientId, clientIdLength);
+    }
+    else
+    {
+        session.clientId = "broker-" + std::to_string(++assignedIdentifiers);
+    }
+
+    // A new connection with the same client identifier takes over the old one
+    for (BrokerSession &other : sessions)
+    {
+        if (&other != &session && other.open && other.connected && other.clientId == session.clientId)
+        {
+            close(other);
+        }
+    }
+
+    session.connected = true;
+
+    acknowledge.setReasonCode(ReasonCode::SUCCESS);
+    acknowledge.setSessionPresent(false);
+    send(session, acknowledge);
+
+    return true;
+}
+
+bool Broker::handleSubscribe(BrokerSession &session, const uint8_t *data, size_t length)
+{
+    FieldReader reader(data, length);
+    uint16_t packetIdentifier;
+
+    if (!reader.readPacketIdentifier(packetIdentifier) || !reader.skipProperties() || reader.empty())
+    {
+        return false;
+    }
+
+    SubscribeAcknowledge acknowledge;
+    acknowledge.setPacketIdentifier(packetIdentifier);
+
+    // Retained messages are sent after the SUBACK
+    std::vector<std::string> sendRetained;
+
+    while (!reader.empty())
+    {
+        const char *filter;
+        uint16_t filterLength;
+        uint8_t options;
+
+        if (!reader.readString(filter, filterLength) || !reader.readByte(options))
+        {
+            return false;
+        }
+
+        uint8_t qos = options & SUBSCRIPTION_QOS_FLAGS;
+        uint8_t retainHandling = (options >> SUBSCRIPTION_RETAIN_HANDLING_SHIFT) & SUBSCRIPTION_RETAIN_HANDLING_FLAGS;
+
+        if (qos > QoS::TWO || retainHandling > 2)
+        {
+            return false;
+        }
+
+        if (!isValidTopicFilter(filter, filterLength))
+        {
+            acknowledge.addReasonCode(ReasonCode::TOPIC_FILTER_INVALID);
+            continue;
+        }
+
+        if (filterLength >= SHARED_PREFIX_LENGTH && memcmp(filter, SHARED_PREFIX, SHARED_PREFIX_LENGTH) == 0)
+        {
+            acknowledge.addReasonCode(ReasonCode::SHARED_SUBSCRIPTIONS_NOT_SUPPORTED);
+            continue;
+        }
+
+        std::string value(filter, filterLength);
+        bool existing = false;
+
+        for (BrokerSubscription &subscription : session.subscriptions)
+        {
+            if (subscription.filter == value)
+            {
+                subscription.qos = qos;
+                subscription.noLocal = (options & SUBSCRIPTION_NO_LOCAL_FLAGS) != 0;
+                existing = true;
+                break;
+            }
+        }
+
+        if (!existing)
+        {
+            session.subscriptions.push_back({value, qos, (options & SUBSCRIPTION_NO_LOCAL_FLAGS) != 0});
+        }
+
+        if (retainHandling == 0 || (retainHandling == 1 && !existing))
+        {
+            sendRetained.push_back(value);
+        }
+
+        acknowledge.addReasonCode(qos);
+    }
+
+    send(session, acknowledge);
+
+    for (std::string &filter : sendRetained)
+    {
+        uint8_t qos = 0;
+
+        for (BrokerSubscription &subscription : session.subscriptions)
+        {
+            if (subscription.filter == filter)
+            {
+                qos = subscription.qos;
+            }
+        }
+
+        for (auto &[topic, message] : retained)
+        {
+            if (topicMatchesFilter(filter.data(), filter.size(), topic.data(), topic.size()))
+            {
+                uint8_t messageQos = (message.fixedHeader & PUBLISH_QOS_FLAGS) >> PUBLISH_QOS_SHIFT;
+                deliver(session, message.fixedHeader, message.data.data(), message.data.size(),
+                        (messageQos < qos) ? messageQos : qos, true);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Broker::handleUnsubscribe(BrokerSession &session, const uint8_t *data, size_t length)
+{
+    FieldReader reader(data, length);
+    uint16_t packetIdentifier;
+
+    if (!reader.readPacketIdentifier(packetIdentifier) || !reader.skipProperties() || reader.empty())
+    {
+        return false;
+    }
+
+    UnsubscribeAcknowledge acknowledge;
+    acknowledge.setPacketIdentifier(packetIdentifier);
+
+    while (!reader.empty())
+    {
+        const char *filter;
+        uint16_t filterLength;
+
+        if (!reader.readString(filter, filterLength))
+        {
+            return false;
+        }
+
+        std::string value(filter, filterLength);
+        uint8_t reasonCode = ReasonCode::NO_SUBSCRIPTION_FOUND;
+
+        for (auto it = session.subscriptions.begin(); it != session.subscriptions.end(); it++)
+        {
+            if (it->filter == value)
+            {
+                session.subscriptions.erase(it);
+                reasonCode = ReasonCode::SUCCESS;
+                break;
+            }
+        }
+
+        acknowledge.addReasonCode(reasonCode);
+    }
+
+    send(session, acknowledge);
+
+    return true;
+}
+
+bool Broker::handlePublish(BrokerSession &session, uint8_t fixedHeader, const uint8_t *data, size_t length)
+{
+    Publish publish(fixedHeader);
+    uint8_t qos = (fixedHeader & PUBLISH_QOS_FLAGS) >> PUBLISH_QOS_SHIFT;
+
+    if (qos > QoS::TWO || !decode(publish, data, length))
+    {
+        return false;
+    }
+
+    EncodedString &topic = publish.getTopic();
+    const char *name = (const char *)topic.data;
+    size_t nameLength = topic.size() - 2;
+
+    if (!isValidTopicName(name, nameLength))
+    {
+        return false;
+    }
+
+    publishes++;
+
+    if (publish.getRetain())
+    {
+        std::string key(name, nameLength);
+
+        if (publish.getPayload().size() == 0)
+        {
+            retained.erase(key);
+        }
+        else
+        {
+            retained[key] = {fixedHeader, std::vector<uint8_t>(data, data + length)};
+        }
+    }
+
+    for (BrokerSession &subscriber : sessions)
+    {
+        if (!subscriber.open || !subscriber.connected)
+        {
+            continue;
+        }
+
+        // Overlapping subscriptions deliver a single copy at the highest granted QoS
+        int granted = -1;
+
+        for (BrokerSubscription &subscription : subscriber.subscriptions)
+        {
+            if ((subscription.noLocal && &subscriber == &session) ||
+                !topicMatchesFilter(subscription.filter.data(), subscription.filter.size(), name, nameLength))
+            {
+                continue;
+            }
+
+            if (subscription.qos > granted)
+            {
+                granted = subscription.qos;
+            }
+        }
+
+        if (granted >= 0)
+        {
+            deliver(subscriber, fixedHeader, data, length, (qos < granted) ? qos : granted, false);
+        }
+    }
+
+    if (qos == QoS::ONE)
+    {
+        PublishAcknowledge acknowledge;
+        acknowledge.setPacketIdentifier(publish.getPacketIdentifier());
+        send(session, acknowledge);
+    }
+    else if (qos == QoS::TWO)
+    {
+        PublishReceived received;
+        received.setPacketIdentifier(publish.getPacketIdentifier());
+        send(session, received);
+    }
+
+    return true;
+}
+
+void Broker::deliver(BrokerSession &session, uint8_t fixedHeader, const uint8_t *data, size_t length, uint8_t qos, bool retain)
+{
+    // Copies are always first deliveries
+    Publish publish(fixedHeader & ~PUBLISH_DUPLICATE_FLAGS);
+
+    if (!decode(publish, data, length))
+    {
+        return;
+    }
+
+    publish.setQos(QoS::_from_integral(qos));
+    publish.setRetain(retain);
+
+    if (qos != QoS::ZERO)
+    {
+        if (++session.packetIdentifier == 0)
+        {
+            session.packetIdentifier = 1;
+        }
+        publish.setPacketIdentifier(session.packetIdentifier);
+    }
+
+    send(session, publish);
+}
+
+void Broker::send(BrokerSession &session, Packet &packet)
+{
+    PacketBuffer buffer(packet.totalSize());
+    packet.push(buffer);
+
+    if (session.client->write(buffer.getBuffer(), buffer.getLength()) != buffer.getLength())
+    {
+        session.open = false;
+    }
+}
+
+void Broker::close(BrokerSession &session)
+{
+    session.open = false;
+    session.client->stop();
+}
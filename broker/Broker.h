@@ -0,0 +1,161 @@
+/*
+ * File: Broker.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#ifndef BROKER_BROKER
+#define BROKER_BROKER
+
+#include <stdint.h>
+#include <stddef.h>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "Client.h"
+#include "packets/Packet.h"
+
+namespace CppMqtt
+{
+    typedef struct
+    {
+        std::string filter;
+        uint8_t qos;
+        bool noLocal;
+    } BrokerSubscription;
+
+    /**
+     * @brief The state of a single connection to the broker
+     */
+    typedef struct
+    {
+        Client *client;
+        // Received bytes that do not yet form a complete packet
+        std::vector<uint8_t> input;
+        std::string clientId;
+        std::vector<BrokerSubscription> subscriptions;
+        uint16_t packetIdentifier;
+        bool connected;
+        bool open;
+    } BrokerSession;
+
+    typedef struct
+    {
+        uint8_t fixedHeader;
+        // The variable header and payload of the original publish
+        std::vector<uint8_t> data;
+    } RetainedMessage;
+
+    /**
+     * @brief A minimal single process MQTT 5 broker for tests and benchmarks
+     * Routes publishes to matching subscriptions at QoS 0 to 2 and keeps retained messages.
+     * Sessions are not persisted, messages are not queued or retransmitted, and shared
+     * subscriptions, topic aliases and authentication are not supported.
+     */
+    class Broker
+    {
+    private:
+        std::list<BrokerSession> sessions;
+        std::map<std::string, RetainedMessage> retained;
+        uint64_t publishes = 0;
+        uint32_t assignedIdentifiers = 0;
+
+        void process(BrokerSession &session);
+        /**
+         * @brief Handles a single complete packet from a session
+         *
+         * @param session
+         * @param fixedHeader
+         * @param data The variable header and payload
+         * @param length
+         * @return true If the connection should be kept open
+         */
+        bool handle(BrokerSession &session, uint8_t fixedHeader, const uint8_t *data, size_t length);
+        bool handleConnect(BrokerSession &session, const uint8_t *data, size_t length);
+        bool handleSubscribe(BrokerSession &session, const uint8_t *data, size_t length);
+        bool handleUnsubscribe(BrokerSession &session, const uint8_t *data, size_t length);
+        bool handlePublish(BrokerSession &session, uint8_t fixedHeader, const uint8_t *data, size_t length);
+        /**
+         * @brief Sends a copy of a publish to a session
+         *
+         * @param session The receiving session
+         * @param fixedHeader The fixed header of the original publish
+         * @param data The variable header and payload of the original publish
+         * @param length
+         * @param qos The QoS to deliver at
+         * @param retain Whether the retain flag is set on the copy
+         */
+        void deliver(BrokerSession &session, uint8_t fixedHeader, const uint8_t *data, size_t length, uint8_t qos, bool retain);
+        void send(BrokerSession &session, Packet &packet);
+        void close(BrokerSession &session);
+
+    protected:
+    public:
+        /**
+         * @brief Starts serving a connected client
+         * The client must stay valid until it is detached or its session has closed
+         *
+         * @param client
+         */
+        void attach(Client *client);
+        /**
+         * @brief Stops serving a client without closing it
+         *
+         * @param client
+         */
+        void detach(Client *client);
+        /**
+         * @brief Reads and handles all available data from every session
+         * Sessions that have disconnected are removed
+         */
+        void sync();
+        /**
+         * @brief Returns the amount of attached sessions
+         *
+         * @return size_t
+         */
+        size_t sessionCount() { return sessions.size(); };
+        /**
+         * @brief Returns the amount of retained messages
+         *
+         * @return size_t
+         */
+        size_t retainedCount() { return retained.size(); };
+        /**
+         * @brief Returns the amount of publish packets received from all sessions
+         *
+         * @return uint64_t
+         */
+        uint64_t publishesReceived() { return publishes; };
+    };
+}
+
+#endif /* BROKER_BROKER */
@@ -0,0 +1,114 @@
+/*
+ * File: SocketClient.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "SocketClient.h"
+#include <string.h>
+#include <errno.h>
+#include <sys/socket.h>
+
+size_t SocketClient::write(const void *data, size_t size)
+{
+    const uint8_t *position = (const uint8_t *)data;
+    size_t remaining = size;
+
+    while (open && remaining > 0)
+    {
+        ssize_t written = ::send(socket, position, remaining, MSG_NOSIGNAL);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            open = false;
+            break;
+        }
+
+        position += written;
+        remaining -= written;
+    }
+
+    return size - remaining;
+}
+
+int SocketClient::read(void *output, size_t size)
+{
+    size_t count = (size < (end - start)) ? size : (end - start);
+    memcpy(output, buffer + start, count);
+    start += count;
+    return count;
+}
+
+void SocketClient::stop()
+{
+    if (open)
+    {
+        ::shutdown(socket, SHUT_RDWR);
+        open = false;
+    }
+}
+
+void SocketClient::sync()
+{
+    if (!open)
+    {
+        return;
+    }
+
+    if (start == end)
+    {
+        start = end = 0;
+    }
+    else if (start > 0)
+    {
+        memmove(buffer, buffer + start, end - start);
+        end -= start;
+        start = 0;
+    }
+
+    if (end == SOCKET_CLIENT_BUFFER_SIZE)
+    {
+        return;
+    }
+
+    ssize_t received = ::recv(socket, buffer + end, SOCKET_CLIENT_BUFFER_SIZE - end, MSG_DONTWAIT);
+
+    if (received > 0)
+    {
+        end += received;
+    }
+    else if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+    {
+        open = false;
+    }
+}
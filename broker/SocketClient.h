@@ -0,0 +1,70 @@
+/*
+ * File: SocketClient.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef BROKER_SOCKETCLIENT
+#define BROKER_SOCKETCLIENT
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Client.h"
+
+#define SOCKET_CLIENT_BUFFER_SIZE 65536
+
+/**
+ * @brief A client over an already connected stream socket
+ * Received data is buffered on sync so available never needs a system call
+ */
+class SocketClient : public Client
+{
+private:
+    int socket;
+    bool open = true;
+    uint8_t buffer[SOCKET_CLIENT_BUFFER_SIZE];
+    size_t start = 0;
+    size_t end = 0;
+
+protected:
+public:
+    SocketClient(int socket) : socket(socket){};
+    ~SocketClient() override{};
+    int connect(const char *, uint16_t) { return open ? 0 : -1; };
+    size_t write(uint8_t value) { return write(&value, 1); };
+    size_t write(const void *buffer, size_t size);
+    int available() { return end - start; };
+    int read(void *output, size_t size);
+    void stop();
+    uint8_t connected() { return open; };
+    void sync();
+    int getFileDescriptor() { return socket; };
+};
+
+#endif /* BROKER_SOCKETCLIENT */
@@ -0,0 +1,175 @@
+/*
+ * File: Allocator.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "Allocator.h"
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+
+using namespace CppMqtt;
+
+/**
+ * @brief Bookkeeping placed ahead of objects created through allocateObject
+ * Padded to the strictest fundamental alignment so the object keeps the alignment of malloc
+ */
+union ObjectHeader
+{
+    struct
+    {
+        Allocator *allocator;
+        size_t size;
+    } owner;
+    max_align_t alignment;
+};
+
+static MallocAllocator mallocAllocator;
+static Allocator *defaultAllocator = &mallocAllocator;
+static std::atomic<uint32_t> allocationCount(0);
+
+void *MallocAllocator::allocate(size_t size)
+{
+    return malloc(size);
+}
+
+void MallocAllocator::deallocate(void *pointer, size_t)
+{
+    free(pointer);
+}
+
+FixedPoolAllocator::FixedPoolAllocator(size_t blockSize, size_t blockCount)
+{
+    // Blocks hold the free list link while unused and keep malloc alignment
+    blockSize = (blockSize < sizeof(void *)) ? sizeof(void *) : blockSize;
+    blockSize = (blockSize + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+
+    this->blockSize = blockSize;
+    this->blockCount = blockCount;
+
+    memory = (uint8_t *)malloc(blockSize * blockCount);
+
+    if (memory == NULL)
+    {
+        this->blockCount = 0;
+        return;
+    }
+
+    for (size_t i = blockCount; i > 0; i--)
+    {
+        void *block = memory + (i - 1) * blockSize;
+        *(void **)block = freeList;
+        freeList = block;
+    }
+}
+
+FixedPoolAllocator::~FixedPoolAllocator()
+{
+    free(memory);
+}
+
+void *FixedPoolAllocator::allocate(size_t size)
+{
+    if (size > blockSize || freeList == NULL)
+    {
+        return NULL;
+    }
+
+    void *block = freeList;
+    freeList = *(void **)block;
+    return block;
+}
+
+void FixedPoolAllocator::deallocate(void *pointer, size_t)
+{
+    if (pointer == NULL)
+    {
+        return;
+    }
+
+    *(void **)pointer = freeList;
+    freeList = pointer;
+}
+
+bool FixedPoolAllocator::owns(const void *pointer) const
+{
+    const uint8_t *address = (const uint8_t *)pointer;
+    return memory != NULL && address >= memory && address < memory + blockSize * blockCount;
+}
+
+Allocator *CppMqtt::getDefaultAllocator()
+{
+    return defaultAllocator;
+}
+
+Allocator *CppMqtt::setDefaultAllocator(Allocator *allocator)
+{
+    Allocator *previous = defaultAllocator;
+    defaultAllocator = (allocator != NULL) ? allocator : &mallocAllocator;
+    return previous;
+}
+
+void *CppMqtt::allocateFrom(Allocator *allocator, size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return allocator->allocate(size);
+}
+
+uint32_t CppMqtt::getAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void *CppMqtt::allocateObject(size_t size)
+{
+    Allocator *allocator = defaultAllocator;
+    ObjectHeader *header = (ObjectHeader *)allocateFrom(allocator, sizeof(ObjectHeader) + size);
+
+    if (header == NULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    header->owner.allocator = allocator;
+    header->owner.size = sizeof(ObjectHeader) + size;
+
+    return header + 1;
+}
+
+void CppMqtt::deallocateObject(void *pointer)
+{
+    if (pointer == NULL)
+    {
+        return;
+    }
+
+    ObjectHeader *header = (ObjectHeader *)pointer - 1;
+    header->owner.allocator->deallocate(header, header->owner.size);
+}
@@ -0,0 +1,156 @@
+/*
+ * File: Allocator.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef ALLOCATOR
+#define ALLOCATOR
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace CppMqtt
+{
+    /**
+     * @brief Source of heap memory for the library
+     * Every buffer, payload, property and packet allocated by the library goes through an Allocator,
+     * memory is always returned to the Allocator it was taken from.
+     */
+    class Allocator
+    {
+    public:
+        virtual ~Allocator(){};
+        /**
+         * @brief Reserves memory suitable for any object type
+         *
+         * @param size The amount of bytes required
+         * @return void* The reserved memory, NULL if the allocation failed
+         */
+        virtual void *allocate(size_t size) = 0;
+        /**
+         * @brief Returns memory reserved by allocate
+         *
+         * @param pointer The memory to return, may be NULL
+         * @param size The size originally requested
+         */
+        virtual void deallocate(void *pointer, size_t size) = 0;
+    };
+
+    /**
+     * @brief Allocator backed by malloc and free, used when no other Allocator is set
+     */
+    class MallocAllocator : public Allocator
+    {
+    public:
+        void *allocate(size_t size) override;
+        void deallocate(void *pointer, size_t size) override;
+    };
+
+    /**
+     * @brief Allocator handing out a fixed number of equally sized blocks reserved at construction
+     * Requests larger than a block, or made once all blocks are in use, fail with NULL.
+     */
+    class FixedPoolAllocator : public Allocator
+    {
+    private:
+        uint8_t *memory = NULL;
+        size_t blockSize;
+        size_t blockCount;
+        // Singly linked list of free blocks threaded through the blocks themselves
+        void *freeList = NULL;
+
+    public:
+        FixedPoolAllocator(size_t blockSize, size_t blockCount);
+        FixedPoolAllocator(const FixedPoolAllocator &) = delete;
+        FixedPoolAllocator &operator=(const FixedPoolAllocator &) = delete;
+        ~FixedPoolAllocator();
+
+        void *allocate(size_t size) override;
+        void deallocate(void *pointer, size_t size) override;
+        /**
+         * @brief Returns whether a pointer was reserved by this pool
+         *
+         * @param pointer
+         * @return true
+         * @return false
+         */
+        bool owns(const void *pointer) const;
+    };
+
+    /**
+     * @brief Returns the Allocator used for new allocations
+     *
+     * @return Allocator*
+     */
+    Allocator *getDefaultAllocator();
+    /**
+     * @brief Sets the Allocator used for new allocations
+     * Memory already reserved is still returned to the Allocator it came from, so the previous
+     * Allocator must outlive anything allocated from it.
+     *
+     * @param allocator The new Allocator, NULL restores the malloc Allocator
+     * @return Allocator* The previous Allocator
+     */
+    Allocator *setDefaultAllocator(Allocator *allocator);
+
+    /**
+     * @brief Reserves memory from an Allocator on behalf of the library
+     * Counts the allocation, see getAllocationCount
+     *
+     * @param allocator
+     * @param size
+     * @return void* The reserved memory, NULL if the allocation failed
+     */
+    void *allocateFrom(Allocator *allocator, size_t size);
+    /**
+     * @brief Returns the amount of allocations the library has made since startup
+     * Wraps around on overflow, so only the difference between two readings is meaningful
+     *
+     * @return uint32_t
+     */
+    uint32_t getAllocationCount();
+
+    /**
+     * @brief Reserves memory for a heap object, recording the Allocator ahead of the object
+     * Used by the class level operator new of packets and properties, throws std::bad_alloc on failure
+     *
+     * @param size
+     * @return void*
+     */
+    void *allocateObject(size_t size);
+    /**
+     * @brief Returns memory reserved by allocateObject to its Allocator
+     *
+     * @param pointer
+     */
+    void deallocateObject(void *pointer);
+}
+
+#endif /* ALLOCATOR */
@@ -0,0 +1,63 @@
+/*
+ * File: BufferClient.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef BUFFERCLIENT
+#define BUFFERCLIENT
+
+#include <stdint.h>
+#include <string.h>
+#include "Client.h"
+
+/**
+ * @brief A read only client over a range of memory
+ * Allows data that has already been received to be decoded with the readFromClient methods
+ */
+class BufferClient : public Client
+{
+private:
+    const uint8_t *buffer;
+    size_t length;
+    size_t position = 0;
+
+protected:
+public:
+    BufferClient(const void *buffer, size_t length) : buffer((const uint8_t *)buffer), length(length){};
+    int connect(const char *, uint16_t) { return 0; };
+    size_t write(uint8_t) { return 0; };
+    size_t write(const void *, size_t) { return 0; };
+    int available() { return length - position; };
+    int read(void *output, size_t size);
+    void stop(){};
+    uint8_t connected() { return 1; };
+    void sync(){};
+};
+
+#endif /* BUFFERCLIENT */
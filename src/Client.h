@@ -40,6 +40,7 @@
 class Client
 {
 public:
+    virtual ~Client(){};
     virtual int connect(const char *host, uint16_t port) = 0;
     virtual size_t write(uint8_t) = 0;
     virtual size_t write(const void *buffer, size_t size) = 0;
@@ -48,6 +49,19 @@ public:
     virtual void stop() = 0;
     virtual uint8_t connected() = 0;
     virtual void sync() = 0;
+    /**
+     * @brief Returns a descriptor that becomes readable when data arrives, for waiting on with poll or epoll
+     *
+     * @return int -1 if the client has none
+     */
+    virtual int getFileDescriptor() { return -1; };
+    /**
+     * @brief Returns whether written data is queued waiting for the descriptor to become writable
+     *
+     * @return true
+     * @return false
+     */
+    virtual bool writePending() { return false; };
 };
 
 #endif /* CLIENT */
\ No newline at end of file
@@ -0,0 +1,81 @@
+/*
+ * File: Clock.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "Clock.h"
+
+#if defined(PICO)
+#include "pico/stdlib.h"
+#elif defined(ARDUINO) || defined(ESP8266) || defined(ESP32)
+#include <Arduino.h>
+#elif defined(__linux__)
+#include <chrono>
+#endif
+
+using namespace CppMqtt;
+
+static MonotonicClock monotonicClock;
+static Clock *defaultClock = &monotonicClock;
+
+uint64_t MonotonicClock::microseconds()
+{
+#if defined(PICO)
+    return time_us_64();
+#elif defined(ARDUINO) || defined(ESP8266) || defined(ESP32)
+    uint32_t now = micros();
+
+    // micros wraps every 71 minutes
+    if (now < last)
+    {
+        wraps += (uint64_t)1 << 32;
+    }
+
+    last = now;
+
+    return wraps + now;
+#elif defined(__linux__)
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+Clock *CppMqtt::getDefaultClock()
+{
+    return defaultClock;
+}
+
+Clock *CppMqtt::setDefaultClock(Clock *clock)
+{
+    Clock *previous = defaultClock;
+    defaultClock = (clock != NULL) ? clock : &monotonicClock;
+    return previous;
+}
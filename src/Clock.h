@@ -0,0 +1,99 @@
+/*
+ * File: Clock.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef CLOCK
+#define CLOCK
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace CppMqtt
+{
+    /**
+     * @brief Source of time for the library
+     * Time must never go backwards, so wall clock time that can be stepped by NTP is not suitable.
+     */
+    class Clock
+    {
+    public:
+        virtual ~Clock(){};
+        /**
+         * @brief Returns the time in microseconds since an arbitrary starting point
+         *
+         * @return uint64_t
+         */
+        virtual uint64_t microseconds() = 0;
+    };
+
+    /**
+     * @brief Clock backed by the monotonic timer of the platform, used when no other Clock is set
+     * Uses time_us_64 on the Pico, micros on Arduino extended past its 32 bit wrap and steady_clock on linux.
+     */
+    class MonotonicClock : public Clock
+    {
+    private:
+#if defined(ARDUINO) || defined(ESP8266) || defined(ESP32)
+        uint32_t last = 0;
+        uint64_t wraps = 0;
+#endif
+
+    public:
+        uint64_t microseconds() override;
+    };
+
+    /**
+     * @brief Returns the Clock used by the library
+     *
+     * @return Clock*
+     */
+    Clock *getDefaultClock();
+    /**
+     * @brief Sets the Clock used by the library, for example to drive time in tests
+     * Should be set before any client is created, as clients keep the time of their last sync
+     *
+     * @param clock The new Clock, NULL restores the monotonic Clock
+     * @return Clock* The previous Clock
+     */
+    Clock *setDefaultClock(Clock *clock);
+
+    /**
+     * @brief Returns the time of the default Clock in microseconds
+     *
+     * @return uint64_t
+     */
+    inline uint64_t currentMicroseconds()
+    {
+        return getDefaultClock()->microseconds();
+    }
+}
+
+#endif /* CLOCK */
@@ -0,0 +1,131 @@
+/*
+ * File: LatencyHistogram.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#include "LatencyHistogram.h"
+
+using namespace CppMqtt;
+
+#define SUB_BUCKET_MASK (LATENCY_HISTOGRAM_SUB_BUCKETS - 1)
+
+size_t LatencyHistogram::bucketIndex(uint32_t value)
+{
+    if (value < LATENCY_HISTOGRAM_SUB_BUCKETS)
+    {
+        return value;
+    }
+
+    // Position of the highest set bit selects the range, the bits below it select the bucket within the range
+    uint32_t exponent = 31 - __builtin_clz(value);
+    uint32_t shift = exponent - LATENCY_HISTOGRAM_PRECISION;
+
+    return ((shift + 1) << LATENCY_HISTOGRAM_PRECISION) + ((value >> shift) & SUB_BUCKET_MASK);
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(size_t index)
+{
+    if (index < LATENCY_HISTOGRAM_SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    uint32_t shift = (index >> LATENCY_HISTOGRAM_PRECISION) - 1;
+    uint64_t lower = (uint64_t)(LATENCY_HISTOGRAM_SUB_BUCKETS + (index & SUB_BUCKET_MASK)) << shift;
+
+    return lower + ((uint64_t)1 << shift) - 1;
+}
+
+void LatencyHistogram::record(uint32_t value)
+{
+    std::atomic<uint32_t> &bucket = buckets[bucketIndex(value)];
+
+    // Single writer, so a load and store is enough
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (value < minimum.load(std::memory_order_relaxed))
+    {
+        minimum.store(value, std::memory_order_relaxed);
+    }
+
+    if (value > maximum.load(std::memory_order_relaxed))
+    {
+        maximum.store(value, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
+    count.store(0, std::memory_order_relaxed);
+    minimum.store(UINT32_MAX, std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+}
+
+uint32_t LatencyHistogram::getMinimum() const
+{
+    return (getCount() > 0) ? minimum.load(std::memory_order_relaxed) : 0;
+}
+
+uint32_t LatencyHistogram::getPercentile(double percentile) const
+{
+    uint32_t total = getCount();
+
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the value, at least the first value
+    uint64_t rank = (uint64_t)((percentile / 100.0) * total + 0.5);
+    rank = (rank == 0) ? 1 : rank;
+
+    uint64_t seen = 0;
+    uint32_t maximumValue = getMaximum();
+
+    for (size_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++)
+    {
+        seen += getBucket(i);
+
+        if (seen >= rank)
+        {
+            uint32_t bound = bucketUpperBound(i);
+            return (bound < maximumValue) ? bound : maximumValue;
+        }
+    }
+
+    return maximumValue;
+}
@@ -0,0 +1,106 @@
+/*
+ * File: LatencyHistogram.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#ifndef SRC_LATENCYHISTOGRAM
+#define SRC_LATENCYHISTOGRAM
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// Each power of two range is split into 2^LATENCY_HISTOGRAM_PRECISION linear buckets,
+// bounding the relative error of a recorded value to 1 / 2^LATENCY_HISTOGRAM_PRECISION
+#ifndef LATENCY_HISTOGRAM_PRECISION
+#define LATENCY_HISTOGRAM_PRECISION 3
+#endif
+
+#define LATENCY_HISTOGRAM_SUB_BUCKETS (1 << LATENCY_HISTOGRAM_PRECISION)
+#define LATENCY_HISTOGRAM_BUCKETS ((32 - LATENCY_HISTOGRAM_PRECISION + 1) * LATENCY_HISTOGRAM_SUB_BUCKETS)
+
+namespace CppMqtt
+{
+    /**
+     * @brief A fixed size histogram of 32 bit values with logarithmically sized buckets
+     * Values below 2^LATENCY_HISTOGRAM_PRECISION are recorded exactly, larger values within a bounded
+     * relative error. Recording is constant time and never allocates.
+     * Like MqttClientStats, only one thread records while any thread may read.
+     */
+    class LatencyHistogram
+    {
+    private:
+        std::atomic<uint32_t> buckets[LATENCY_HISTOGRAM_BUCKETS] = {};
+        std::atomic<uint32_t> count{0};
+        std::atomic<uint32_t> minimum{UINT32_MAX};
+        std::atomic<uint32_t> maximum{0};
+
+    protected:
+    public:
+        /**
+         * @brief Returns the bucket a value is recorded in
+         *
+         * @param value
+         * @return size_t
+         */
+        static size_t bucketIndex(uint32_t value);
+        /**
+         * @brief Returns the largest value recorded in a bucket
+         *
+         * @param index
+         * @return uint32_t
+         */
+        static uint32_t bucketUpperBound(size_t index);
+
+        void record(uint32_t value);
+        void reset();
+
+        uint32_t getCount() const { return count.load(std::memory_order_relaxed); };
+        /**
+         * @brief Returns the smallest value recorded
+         *
+         * @return uint32_t The smallest value, 0 if nothing has been recorded
+         */
+        uint32_t getMinimum() const;
+        uint32_t getMaximum() const { return maximum.load(std::memory_order_relaxed); };
+        uint32_t getBucket(size_t index) const { return buckets[index].load(std::memory_order_relaxed); };
+        /**
+         * @brief Returns the value at or below which a percentage of the recorded values fall
+         * Reported as the upper bound of the bucket holding the value, capped at the maximum
+         *
+         * @param percentile Between 0 and 100
+         * @return uint32_t The value, 0 if nothing has been recorded
+         */
+        uint32_t getPercentile(double percentile) const;
+    };
+}
+
+#endif /* SRC_LATENCYHISTOGRAM */
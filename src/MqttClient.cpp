@@ -30,7 +30,9 @@
  */
 
 #include "MqttClient.h"
+#include "Allocator.h"
 #include "packets/PacketUtility.h"
+#include "utils/Utf8.h"
 #include <algorithm>
 
 #ifdef DEBUGGING
@@ -49,20 +51,33 @@ using namespace std;
 
 namespace CppMqtt
 {
-
     Packet *MqttClient::readNextPacket()
     {
-        Packet *packet = readPacketFromClient(client);
+        uint32_t read = 0;
+        Packet *packet = readPacketFromClient(client, packetPool, read);
+
+        // Counted from what was read rather than available, which can grow while reading
+        stats.addBytesReceived(read);
 
         if (packet == NULL)
         {
             return NULL;
         }
 
-        serverKeepAliveTimeRemaining = (getKeepAliveInterval() * KEEP_ALIVE_SCALER);
+        scheduleKeepAlive(serverKeepAliveTimer, getKeepAliveInterval() * KEEP_ALIVE_SCALER);
 
         uint8_t packetType = packet->getPacketType();
 
+        stats.packetReceived(packetType);
+
+        if (packet->malformed())
+        {
+            stats.parseError();
+            packetPool.release(packet);
+            disconnect(ReasonCode::MALFORMED_PACKET);
+            return NULL;
+        }
+
         switch (packetType)
         {
         case PacketId::CONNECT:
@@ -77,6 +92,24 @@ namespace CppMqtt
         case PacketId::PUBLISH:
         {
             Publish *publish = (Publish *)packet;
+            if (!publish->validate())
+            {
+                ReasonCode reason = ReasonCode::TOPIC_NAME_INVALID;
+
+                // Badly encoded strings make the packet malformed, an invalid UTF-8 payload has its own reason
+                if (!publish->getTopic().validate())
+                {
+                    reason = ReasonCode::MALFORMED_PACKET;
+                }
+                else if (publish->hasUtf8Payload() && !isValidUtf8(publish->getPayload().getData(), publish->getPayload().size()))
+                {
+                    reason = ReasonCode::PAYLOAD_FORMAT_INVALID;
+                }
+
+                stats.parseError();
+                disconnect(reason);
+                break;
+            }
             onPublish(publish);
         }
         break;
@@ -98,9 +131,13 @@ namespace CppMqtt
         case PacketId::SUBSCRIBE_ACKNOWLEDGE:
         {
             SubscribeAcknowledge *acknowledge = (SubscribeAcknowledge *)packet;
-            if (handler)
+            if (handlerV2)
+            {
+                handlerV2->onSubscribeResult(acknowledge->getPacketIdentifier(), acknowledge->getReasonCodes());
+            }
+            else if (handlerV1)
             {
-                handler->onSubscribeResult(acknowledge->getPacketIdentifier(), acknowledge->getReasonCodes());
+                handlerV1->onSubscribeResult(acknowledge->getPacketIdentifier(), acknowledge->getReasonCodes());
             }
         }
         break;
@@ -110,16 +147,19 @@ namespace CppMqtt
         case PacketId::UNSUBSCRIBE_ACKNOWLEDGE:
         {
             ReasonsAcknowledge *acknowledge = (ReasonsAcknowledge *)packet;
-            if (handler)
+            if (handlerV2)
+            {
+                handlerV2->onUnsubscribeResult(acknowledge->getPacketIdentifier(), acknowledge->getReasonCodes());
+            }
+            else if (handlerV1)
             {
-                handler->onUnsubscribeResult(acknowledge->getPacketIdentifier(), acknowledge->getReasonCodes());
+                handlerV1->onUnsubscribeResult(acknowledge->getPacketIdentifier(), acknowledge->getReasonCodes());
             }
         }
         break;
         case PacketId::PING_REQUEST:
         {
-            PingResponse response;
-            sendPacket(&response);
+            sendTemplate(PING_RESPONSE_TEMPLATE);
             break;
         }
         case PacketId::PING_RESPONSE:
@@ -128,12 +168,14 @@ namespace CppMqtt
         case PacketId::DISCONNECT:
         {
             Disconnect *disconnect = (Disconnect *)packet;
-            setConnectionState(ConnectionState::DISCONNECTED);
+            // Nothing more may be sent on this connection, a new one has to be made
+            closeConnection();
             if (ReasonCode::_is_valid(disconnect->getReasonCode()))
             {
                 if (handler)
                     handler->onDisconnection(ReasonCode::_from_integral_unchecked(disconnect->getReasonCode()));
             }
+            scheduleReconnect();
         }
         break;
         case PacketId::AUTHENTICATION:
@@ -143,13 +185,12 @@ namespace CppMqtt
         default:
         {
             DEBUG("Not Recognized: %d\n", packet->getPacketType());
+            stats.parseError();
             break;
         }
         }
 
-#ifndef STATIC_MEMORY
-        delete packet;
-#endif
+        packetPool.release(packet);
 
         return NULL;
     }
@@ -175,11 +216,22 @@ namespace CppMqtt
         {
             free(this->address);
         }
+
+        for (auto &queued : publishQueue)
+        {
+            delete queued.second;
+        }
+
+        for (auto &entry : spareQueueEntries)
+        {
+            delete entry.mapped();
+        }
     }
 
     int MqttClient::setWill(WillProperties *will)
     {
         connectPacket.setWill(will);
+        serializedConnect.clear();
         return 0;
     }
 
@@ -199,24 +251,26 @@ namespace CppMqtt
         this->port = port;
         this->connectTimeout = connectTimeout;
 
+        // An explicit connect rebuilds the CONNECT packet and resets the reconnect engine
+        serializedConnect.clear();
+        attemptingReconnect = false;
+        reconnectTimer.cancel();
+        reconnectAttempts = 0;
+        seedReconnectJitter();
+        packetPool.resetProgress();
+
         if (client->connect(address, port) != 0)
         {
             setClientConnectionState(ConnectionState::DISCONNECTED);
             DEBUG("Communication Client failed to connect.\n");
-            // TODO: Error handle
+            scheduleReconnect();
             return -1;
         }
 
         setClientConnectionState(ConnectionState::CONNECTING);
+        timers->schedule(connectTimer, connectTimeout);
+        lastExecutionTime = currentMicroseconds();
 
-#if defined(PICO)
-        lastExecutionTime = time_us_64();
-#elif defined(ARDUINO) || defined(ESP8266) || defined(ESP32)
-        uint32_t now = millis();
-        lastExecutionTime = millis();
-#elif defined(__linux__)
-        lastExecutionTime = std::chrono::system_clock::now();
-#endif
         return 0;
     }
 
@@ -226,10 +280,10 @@ namespace CppMqtt
         {
             return -1;
         }
-        Disconnect disconnect;
-        disconnect.setReasonCode(reasonCode);
-        sendPacket(&disconnect);
-        setConnectionState(ConnectionState::DISCONNECTED);
+        sendTemplate(disconnectTemplate(reasonCode));
+        closeConnection();
+        attemptingReconnect = false;
+        reconnectTimer.cancel();
         if (handler)
         {
             handler->onDisconnection(reasonCode);
@@ -273,12 +327,17 @@ namespace CppMqtt
             return -1;
         }
 
-        Token identifier = getPacketIdentifier();
-
         Subscribe packet;
 
         addSubscribePayload(packet, payload);
 
+        if (!packet.validate())
+        {
+            return -1;
+        }
+
+        Token identifier = getPacketIdentifier();
+
         packet.setPacketIdentifier(identifier);
 
         sendPacket(&packet);
@@ -293,12 +352,17 @@ namespace CppMqtt
             return -1;
         }
 
-        Token identifier = getPacketIdentifier();
-
         Unsubscribe packet;
 
         addUnsubscribePayload(packet, payload);
 
+        if (!packet.validate())
+        {
+            return -1;
+        }
+
+        Token identifier = getPacketIdentifier();
+
         packet.setPacketIdentifier(identifier);
 
         sendPacket(&packet);
@@ -308,9 +372,22 @@ namespace CppMqtt
 
     void MqttClient::sync()
     {
+        uint32_t allocations = getAllocationCount();
+
         client->sync();
         uint32_t elapsed = getElapsed();
 
+        if (attemptingReconnect)
+        {
+            reconnectElapsed += elapsed;
+        }
+
+        // Keep alive, connect timeouts and reconnects expire from the wheel, a shared wheel is advanced by its owner
+        if (timers == &ownTimers)
+        {
+            ownTimers.advance(elapsed);
+        }
+
         if (client->connected())
         {
             if (connectionState == +ConnectionState::DISCONNECTED)
@@ -319,7 +396,7 @@ namespace CppMqtt
             }
             else
             {
-                updateKeepAlivePeriod(elapsed);
+                flushUnsent();
                 readNextPacket();
             }
 
@@ -344,66 +421,345 @@ namespace CppMqtt
                         handler->onDeliveryComplete(identifier);
                     }
                 }
+
+                // Also refreshes the queue depth now the QoS 0 results are reported
+                sendQueued();
             }
         }
-        else
+        else if (connectionState != +ConnectionState::DISCONNECTED || clientState == +ConnectionState::CONNECTED)
         {
-            if (connectionState == +ConnectionState::CONNECTED)
+            // The transport was lost after the session started, including after the server sent DISCONNECT.
+            // A transport still connecting is left to the connect timeout
+            bool wasConnected = connectionState == +ConnectionState::CONNECTED;
+
+            connectTimer.cancel();
+            setClientConnectionState(ConnectionState::DISCONNECTED);
+            setConnectionState(ConnectionState::DISCONNECTED);
+            if (handler && wasConnected)
             {
-                setClientConnectionState(ConnectionState::DISCONNECTED);
-                setConnectionState(ConnectionState::DISCONNECTED);
                 handler->onDisconnection(ReasonCode::UNSPECIFIED_ERROR);
             }
-            else if (clientState == +ConnectionState::CONNECTING)
-            {
-                if (elapsed > this->connectTimeout)
-                {
-                    setConnectionState(ConnectionState::DISCONNECTED);
-                    setClientConnectionState(ConnectionState::DISCONNECTED);
-                    client->stop();
-                    handler->onDisconnection(ReasonCode::UNSPECIFIED_ERROR);
-                }
-                else
-                {
-                    this->connectTimeout -= elapsed;
-                }
-            }
+            scheduleReconnect();
+        }
+
+        stats.addAllocations(getAllocationCount() - allocations);
+    }
+
+    void MqttClient::scheduleReconnect()
+    {
+        if (autoReconnect < 0 || address == nullptr)
+        {
+            return;
+        }
+
+        if (!attemptingReconnect)
+        {
+            attemptingReconnect = true;
+            reconnectAttempts = 0;
+            reconnectElapsed = 0;
+        }
+
+        uint32_t delay = nextReconnectDelay();
+        timers->schedule(reconnectTimer, delay);
+        DEBUG("Reconnecting in %u ms.\n", delay);
+    }
+
+    void MqttClient::reconnect()
+    {
+        if (!attemptingReconnect || client->connected() || clientState == +ConnectionState::CONNECTING)
+        {
+            return;
+        }
+
+        reconnectAttempts++;
+        reconnectStatistics.attempts++;
+        packetPool.resetProgress();
+
+        if (client->connect(address, port) != 0)
+        {
+            DEBUG("Reconnect attempt %u failed.\n", reconnectAttempts);
+            scheduleReconnect();
+            return;
+        }
+
+        timers->schedule(connectTimer, connectTimeout);
+        setClientConnectionState(ConnectionState::CONNECTING);
+    }
+
+    void MqttClient::connectTimedOut()
+    {
+        if (client->connected() || clientState != +ConnectionState::CONNECTING)
+        {
+            return;
+        }
+
+        closeConnection();
+        if (handler)
+        {
+            handler->onDisconnection(ReasonCode::UNSPECIFIED_ERROR);
+        }
+        scheduleReconnect();
+    }
+
+    void MqttClient::closeConnection()
+    {
+        connectTimer.cancel();
+        setConnectionState(ConnectionState::DISCONNECTED);
+        setClientConnectionState(ConnectionState::DISCONNECTED);
+        client->stop();
+    }
+
+    uint32_t MqttClient::nextReconnectDelay()
+    {
+        uint32_t delay = max<uint32_t>(autoReconnect, 1);
+
+        // Doubles the delay for every failed attempt, saturating at the cap
+        for (uint32_t i = 0; i < reconnectAttempts && delay < maximumReconnectDelay; i++)
+        {
+            delay <<= 1;
+        }
+
+        delay = min(delay, maximumReconnectDelay);
+
+        // xorshift32, cheap enough for embedded targets
+        reconnectSeed ^= reconnectSeed << 13;
+        reconnectSeed ^= reconnectSeed >> 17;
+        reconnectSeed ^= reconnectSeed << 5;
+
+        uint32_t half = delay / 2;
+        return (delay - half) + (reconnectSeed % (half + 1));
+    }
+
+    void MqttClient::seedReconnectJitter()
+    {
+        uint64_t now = currentMicroseconds();
+
+        reconnectSeed ^= (uint32_t)now ^ (uint32_t)(now >> 32) ^ (uint32_t)(uintptr_t)this;
+
+        if (reconnectSeed == 0)
+        {
+            reconnectSeed = 1;
         }
     }
 
     int MqttClient::sendPacket(Packet *packet)
     {
-        PacketBuffer packetBuffer(packet->totalSize());
-        packet->push(packetBuffer);
-        return client->write(packetBuffer.getBuffer(), packetBuffer.getLength());
+        sendBuffer.reset(packet->totalSize());
+        packet->push(sendBuffer);
+        return write(sendBuffer.getBuffer(), sendBuffer.getLength());
     }
 
-    void MqttClient::updateKeepAlivePeriod(uint32_t timeElapsed)
+    int MqttClient::write(const uint8_t *data, size_t length)
     {
-        if (getKeepAliveInterval() > 0)
+        // Packets are never interleaved, anything written while a packet is unfinished waits behind it
+        if (!flushUnsent())
+        {
+            unsent.insert(unsent.end(), data, data + length);
+            stats.packetSent(data[0], length);
+            return length;
+        }
+
+        int written = client->write(data, length);
+
+        // The transport took part of the packet, the rest is written once it accepts more
+        if (written >= 0 && (size_t)written < length && client->connected())
+        {
+            unsent.assign(data + written, data + length);
+            unsentPosition = 0;
+            written = length;
+        }
+
+        if (written > 0)
         {
-            if (serverKeepAliveTimeRemaining <= timeElapsed)
+            stats.packetSent(data[0], written);
+        }
+
+        return written;
+    }
+
+    bool MqttClient::congested()
+    {
+        return unsentPosition < unsent.size() || queuedPublishes > 0 || client->writePending();
+    }
+
+    bool MqttClient::flushUnsent()
+    {
+        if (unsentPosition < unsent.size())
+        {
+            int written = client->write(unsent.data() + unsentPosition, unsent.size() - unsentPosition);
+
+            if (written > 0)
             {
-                disconnect(ReasonCode::KEEP_ALIVE_TIMEOUT);
+                unsentPosition += written;
             }
-            else
+
+            if (unsentPosition < unsent.size())
+            {
+                return false;
+            }
+        }
+
+        unsent.clear();
+        unsentPosition = 0;
+
+        return true;
+    }
+
+    void MqttClient::sendQueued()
+    {
+        while (queuedPublishes > 0 && flushUnsent() && !client->writePending())
+        {
+            int lane = PUBLISH_PRIORITIES - 1;
+
+            // Highest priority first, oldest first within a lane
+            while (outboundQueues[lane].size() == 0)
             {
-                serverKeepAliveTimeRemaining -= timeElapsed;
+                lane--;
             }
 
-            if (clientKeepAliveTimeRemaining <= timeElapsed)
+            list<QueuedPublish> &queue = outboundQueues[lane];
+            QueuedPublish &entry = queue.front();
+
+            if (entry.expiryOffset > 0)
             {
+                uint64_t waited = (currentMicroseconds() - entry.queuedTime) / 1000000;
 
-                if (connectionState == +ConnectionState::CONNECTED)
+                // The wheel may not have caught up with the clock yet
+                if (waited >= entry.expiry)
                 {
-                    ping();
+                    expireQueued(queue.begin());
+                    continue;
                 }
+
+                // The receiver is sent the time the message has left rather than its original interval
+                uint32_t remaining = entry.expiry - waited;
+                uint8_t *value = entry.data.data() + entry.expiryOffset;
+
+                value[0] = remaining >> 24;
+                value[1] = remaining >> 16;
+                value[2] = remaining >> 8;
+                value[3] = remaining;
             }
-            else
+
+            if (entry.qos != +QoS::ZERO)
+            {
+                entry.timing.sentTime = currentMicroseconds();
+            }
+
+            int result = write(entry.data.data(), entry.data.size());
+
+            publishSent(entry.qos, entry.token, result, entry.timing);
+            queue.pop_front();
+            queuedPublishes--;
+        }
+
+        updateQueueDepth();
+    }
+
+    void MqttClient::queuePublish(PacketBuffer &buffer, size_t expiryOffset, uint32_t expiry, QoS qos, Token token, DeliveryTiming timing,
+                                  PublishPriority priority)
+    {
+        list<QueuedPublish> &queue = outboundQueues[priority._to_integral()];
+
+        queue.emplace_back();
+        queuedPublishes++;
+
+        auto entry = prev(queue.end());
+
+        entry->data.assign(buffer.getBuffer(), buffer.getBuffer() + buffer.getLength());
+        entry->expiryOffset = expiryOffset;
+        entry->expiry = expiry;
+        entry->queuedTime = currentMicroseconds();
+        entry->token = token;
+        entry->qos = qos;
+        entry->priority = priority;
+        entry->timing = timing;
+
+        if (expiryOffset > 0)
+        {
+            uint64_t delay = (uint64_t)expiry * SECONDS_TO_MS;
+
+            entry->expiryTimer.setCallback([this, entry]() { expireQueued(entry); });
+            timers->schedule(entry->expiryTimer, (delay < UINT32_MAX) ? delay : UINT32_MAX);
+        }
+
+        updateQueueDepth();
+    }
+
+    void MqttClient::updateQueueDepth()
+    {
+        // Publishes waiting to be written and QoS 0 publishes whose delivery is not reported yet
+        stats.setQueueDepth(queuedPublishes + qosZeroSuccess.size() + qosZeroFailed.size());
+    }
+
+    void MqttClient::expireQueued(list<QueuedPublish>::iterator entry)
+    {
+        Token token = entry->token;
+
+        outboundQueues[entry->priority._to_integral()].erase(entry);
+        queuedPublishes--;
+        updateQueueDepth();
+
+        if (handler)
+        {
+            handler->onDeliveryFailure(token, MESSAGE_EXPIRED);
+        }
+    }
+
+    bool MqttClient::isQueued(uint16_t token)
+    {
+        for (list<QueuedPublish> &queue : outboundQueues)
+        {
+            for (QueuedPublish &entry : queue)
             {
-                clientKeepAliveTimeRemaining -= timeElapsed;
+                if (entry.token == token)
+                {
+                    return true;
+                }
             }
         }
+
+        return false;
+    }
+
+    void MqttClient::scheduleKeepAlive(Timer &timer, uint32_t interval)
+    {
+        if (getKeepAliveInterval() > 0)
+        {
+            timers->schedule(timer, interval);
+        }
+        else
+        {
+            timer.cancel();
+        }
+    }
+
+    void MqttClient::clientKeepAliveExpired()
+    {
+        if (client->connected() && connectionState == +ConnectionState::CONNECTED)
+        {
+            ping();
+        }
+    }
+
+    void MqttClient::serverKeepAliveExpired()
+    {
+        if (!client->connected() || connectionState == +ConnectionState::DISCONNECTED)
+        {
+            return;
+        }
+
+        if (connectionState == +ConnectionState::CONNECTED)
+        {
+            sendTemplate(disconnectTemplate(ReasonCode::KEEP_ALIVE_TIMEOUT));
+        }
+
+        closeConnection();
+        if (handler)
+        {
+            handler->onDisconnection(ReasonCode::KEEP_ALIVE_TIMEOUT);
+        }
+        scheduleReconnect();
     }
 
     void MqttClient::setClientConnectionState(ConnectionState state)
@@ -414,11 +770,23 @@ namespace CppMqtt
     void MqttClient::setConnectionState(ConnectionState state)
     {
         connectionState = state;
+
+        if (state == +ConnectionState::DISCONNECTED)
+        {
+            clientKeepAliveTimer.cancel();
+            serverKeepAliveTimer.cancel();
+            // The rest of a partially written packet is meaningless on a new connection, queued publishes are kept
+            unsent.clear();
+            unsentPosition = 0;
+            // Likewise a half read inbound packet
+            packetPool.resetProgress();
+        }
     }
 
     void MqttClient::setCleanStart(bool value)
     {
         connectPacket.setCleanStart(value);
+        serializedConnect.clear();
     }
 
     bool MqttClient::connected()
@@ -434,6 +802,15 @@ namespace CppMqtt
     void MqttClient::setHandler(MqttClientHandler *hander)
     {
         this->handler = hander;
+        handlerV1 = hander;
+        handlerV2 = NULL;
+    }
+
+    void MqttClient::setHandler(MqttClientHandlerV2 *hander)
+    {
+        this->handler = hander;
+        handlerV1 = NULL;
+        handlerV2 = hander;
     }
 
     uint16_t MqttClient::getPacketIdentifier()
@@ -443,36 +820,53 @@ namespace CppMqtt
 
     bool MqttClient::isDelivered(uint16_t token)
     {
-        return !hasClientToken(token);
+        return !hasClientToken(token) && !isQueued(token);
     }
 
     void MqttClient::setClientId(EncodedString &id)
     {
         connectPacket.setClientId(id);
+        serializedConnect.clear();
     }
 
     void MqttClient::setClientId(const char *data, uint16_t length)
     {
         connectPacket.setClientId(data, length);
+        serializedConnect.clear();
     }
 
     void MqttClient::ping()
     {
-        clientKeepAliveTimeRemaining = getKeepAliveInterval() * SECONDS_TO_MS;
-        PingRequest ping;
-        sendPacket(&ping);
+        scheduleKeepAlive(clientKeepAliveTimer, getKeepAliveInterval() * SECONDS_TO_MS);
+        pingSentTime = currentMicroseconds();
+        awaitingPingResponse = true;
+        sendTemplate(PING_REQUEST_TEMPLATE);
     }
 
     void MqttClient::pingResponse()
     {
-        // TODO: Ping Reponse
+        if (awaitingPingResponse)
+        {
+            awaitingPingResponse = false;
+            stats.setPingRoundTrip(currentMicroseconds() - pingSentTime);
+        }
     }
 
-    void MqttClient::messageReceived(EncodedString &topic, Payload &payload)
+    void MqttClient::messageReceived(Publish *packet)
     {
-        if (handler)
+        if (handlerV2)
+        {
+            EncodedString &topic = packet->getTopic();
+            Payload &payload = packet->getPayload();
+            MessageMetadata metadata = {packet->getQos(), packet->getRetain(), packet->getDuplicate(),
+                                        packet->getPacketIdentifier(), &packet->getProperties()};
+
+            handlerV2->onMessage(string_view(topic.data, topic.length),
+                                 span<const uint8_t>(payload.getData(), payload.size()), metadata);
+        }
+        else if (handlerV1)
         {
-            handler->onMessage(topic, payload);
+            handlerV1->onMessage(packet->getTopic(), packet->getPayload());
         }
     }
 
@@ -489,8 +883,21 @@ namespace CppMqtt
             return;
         }
 
+        connectTimer.cancel();
+        setClientConnectionState(ConnectionState::CONNECTED);
         setConnectionState(ConnectionState::CONNECTED);
 
+        if (attemptingReconnect)
+        {
+            attemptingReconnect = false;
+            reconnectAttempts = 0;
+            reconnectStatistics.reconnects++;
+            reconnectStatistics.lastLatency = reconnectElapsed;
+            reconnectStatistics.maximumLatency = max(reconnectStatistics.maximumLatency, reconnectElapsed);
+            reconnectStatistics.totalLatency += reconnectElapsed;
+            stats.reconnected();
+        }
+
         if (handler)
         {
             handler->onConnectionSuccess();
@@ -499,7 +906,10 @@ namespace CppMqtt
         if (packet->getServerKeepAlive() > 0)
         {
             connectPacket.setKeepAliveInterval(packet->getServerKeepAlive());
+            serializedConnect.clear();
         }
+
+        scheduleKeepAlive(clientKeepAliveTimer, getKeepAliveInterval() * SECONDS_TO_MS);
     }
 
     void MqttClient::onPublish(Publish *packet)
@@ -513,28 +923,38 @@ namespace CppMqtt
         {
         case QoS::ZERO:
         {
-            messageReceived(packet->getTopic(), packet->getPayload());
+            messageReceived(packet);
         }
         break;
         case QoS::ONE:
         {
-            messageReceived(packet->getTopic(), packet->getPayload());
-            PublishAcknowledge acknowledge;
-            acknowledge.setPacketIdentifier(identifier);
-            acknowledge.setReasonCode(0);
-            sendPacket(&acknowledge);
+            messageReceived(packet);
+            sendTemplate(withPacketIdentifier(PUBLISH_ACKNOWLEDGE_TEMPLATE, identifier));
         }
         break;
         case QoS::TWO:
         {
-            if (publishQueue.contains(identifier))
-                delete publishQueue[identifier];
+            auto queued = publishQueue.find(identifier);
 
-            publishQueue[identifier] = new Publish(*packet);
-            PublishReceived received;
-            received.setPacketIdentifier(identifier);
-            received.setReasonCode(0);
-            sendPacket(&received);
+            if (queued == publishQueue.end())
+            {
+                if (spareQueueEntries.empty())
+                {
+                    queued = publishQueue.emplace(identifier, new Publish()).first;
+                }
+                else
+                {
+                    auto entry = std::move(spareQueueEntries.back());
+                    spareQueueEntries.pop_back();
+                    entry.key() = identifier;
+                    queued = publishQueue.insert(std::move(entry)).position;
+                }
+            }
+
+            // The received packet is recycled after dispatch, so its contents are swapped rather than copied
+            // which keeps the buffers of both packets in use
+            std::swap(*queued->second, *packet);
+            sendTemplate(withPacketIdentifier(PUBLISH_RECEIVED_TEMPLATE, identifier));
         }
         break;
         default:
@@ -552,6 +972,7 @@ namespace CppMqtt
         {
             if (packet->getReasonCode() == 0)
             {
+                recordDelivery(identifier, QoS::ONE);
                 // TODO: Token Failure
                 if (handler)
                 {
@@ -580,10 +1001,7 @@ namespace CppMqtt
             if (packet->getReasonCode() == 0)
             {
                 // TODO: Token Success
-                PublishRelease release;
-                release.setPacketIdentifier(identifier);
-                release.setReasonCode(0);
-                sendPacket(&release);
+                sendTemplate(withPacketIdentifier(PUBLISH_RELEASE_TEMPLATE, identifier));
             }
             else
             {
@@ -603,18 +1021,15 @@ namespace CppMqtt
         Token identifier = packet->getPacketIdentifier();
         // Validate Packet
 
-        if (publishQueue.contains(identifier))
+        auto queued = publishQueue.find(identifier);
+
+        if (queued != publishQueue.end())
         {
-            Publish *publish = publishQueue[identifier];
-            messageReceived(publish->getTopic(), publish->getPayload());
-            delete publish;
-            publishQueue.erase(identifier);
+            messageReceived(queued->second);
+            spareQueueEntries.push_back(publishQueue.extract(queued));
         }
 
-        PublishComplete complete;
-        complete.setPacketIdentifier(identifier);
-        complete.setReasonCode(0);
-        sendPacket(&complete);
+        sendTemplate(withPacketIdentifier(PUBLISH_COMPLETE_TEMPLATE, identifier));
     }
 
     void MqttClient::onPublishComplete(PublishComplete *packet)
@@ -625,6 +1040,7 @@ namespace CppMqtt
         {
             if (packet->getReasonCode() == 0)
             {
+                recordDelivery(identifier, QoS::TWO);
                 // TODO: Token Success
                 if (handler)
                 {
@@ -645,9 +1061,17 @@ namespace CppMqtt
 
     void MqttClient::mqttConnect()
     {
-        serverKeepAliveTimeRemaining = (getKeepAliveInterval() * KEEP_ALIVE_SCALER);
         setConnectionState(ConnectionState::CONNECTING);
-        sendPacket(&connectPacket);
+        scheduleKeepAlive(serverKeepAliveTimer, getKeepAliveInterval() * KEEP_ALIVE_SCALER);
+
+        if (serializedConnect.empty())
+        {
+            PacketBuffer packetBuffer(connectPacket.totalSize());
+            connectPacket.push(packetBuffer);
+            serializedConnect.assign(packetBuffer.getBuffer(), packetBuffer.getBuffer() + packetBuffer.getLength());
+        }
+
+        write(serializedConnect.data(), serializedConnect.size());
     }
 
     ConnectionState MqttClient::getConnectionState()
@@ -665,44 +1089,21 @@ namespace CppMqtt
 
     void MqttClient::removeClientToken(uint16_t token)
     {
-        clientTokens.erase(find(clientTokens.begin(), clientTokens.end(), token));
+        auto position = find(clientTokens.begin(), clientTokens.end(), token);
+        clientTokenTimings.erase(clientTokenTimings.begin() + (position - clientTokens.begin()));
+        clientTokens.erase(position);
+        stats.setInflight(clientTokens.size());
     }
 
     uint32_t MqttClient::getElapsed()
     {
+        uint64_t now = currentMicroseconds();
+        uint32_t elapsed = (now - lastExecutionTime) / 1000;
 
-#if defined(PICO)
-        uint64_t now = time_us_64();
-        uint64_t duration;
-        if (now < lastExecutionTime)
-        {
-            duration = (now + (0xFFFFFFFF ^ lastExecutionTime)) / 1000;
-        }
-        else
-        {
-            duration = (now - lastExecutionTime) / 1000;
-        }
-        lastExecutionTime = now;
-#elif defined(ARDUINO) || defined(ESP8266) || defined(ESP32)
-        uint32_t now = millis();
-        uint32_t duration;
-        if (now < lastExecutionTime)
-        {
-            duration = (now + (0xFFFF ^ lastExecutionTime));
-        }
-        else
-        {
-            duration = (now - lastExecutionTime);
-        }
-        lastExecutionTime = now;
-#elif defined(__linux__)
-        const auto now = std::chrono::system_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastExecutionTime).count();
-        lastExecutionTime = now;
+        // The remainder is kept for the next call, otherwise syncing more than once a millisecond would never advance
+        lastExecutionTime += (uint64_t)elapsed * 1000;
 
-#endif
-
-        return duration;
+        return elapsed;
     }
 
     uint16_t MqttClient::getKeepAliveInterval()
@@ -713,6 +1114,7 @@ namespace CppMqtt
     void MqttClient::setKeepAliveInterval(uint16_t value)
     {
         connectPacket.setKeepAliveInterval(value);
+        serializedConnect.clear();
     }
 
     uint32_t MqttClient::getSessionExpiryInterval()
@@ -745,6 +1147,16 @@ namespace CppMqtt
     {
     }
 
+    uint32_t MqttClient::getMessageExpiryInterval()
+    {
+        return messageExpiryInterval;
+    }
+
+    void MqttClient::setMessageExpiryInterval(uint32_t value)
+    {
+        messageExpiryInterval = value;
+    }
+
     uint16_t MqttClient::getTopicAliasMaximum()
     {
         return 0;
@@ -785,20 +1197,223 @@ namespace CppMqtt
         return autoReconnect;
     }
 
-    uint16_t MqttClient::publish(EncodedString &topic, Payload &payload, QoS qos, bool retain)
+    void MqttClient::setMaximumReconnectDelay(uint32_t value)
+    {
+        maximumReconnectDelay = value;
+    }
+
+    uint32_t MqttClient::getMaximumReconnectDelay()
+    {
+        return maximumReconnectDelay;
+    }
+
+    ReconnectStatistics MqttClient::getReconnectStatistics()
+    {
+        return reconnectStatistics;
+    }
+
+    int MqttClient::getFileDescriptor()
+    {
+        return client->getFileDescriptor();
+    }
+
+    bool MqttClient::wantsRead()
+    {
+        return client->connected();
+    }
+
+    bool MqttClient::wantsWrite()
+    {
+        return client->connected() && congested();
+    }
+
+    int32_t MqttClient::getTimeout()
+    {
+        if (client->connected())
+        {
+            // Buffered data, a CONNECT to send or QoS 0 results to report are all handled on the next sync
+            if (client->available() > 0 || connectionState == +ConnectionState::DISCONNECTED ||
+                qosZeroFailed.size() > 0 || qosZeroSuccess.size() > 0)
+            {
+                return 0;
+            }
+
+            // Publishes queued before a reconnect are sent as soon as the transport takes them
+            if (connectionState == +ConnectionState::CONNECTED && queuedPublishes > 0 &&
+                unsentPosition == unsent.size() && !client->writePending())
+            {
+                return 0;
+            }
+        }
+        else if (connectionState == +ConnectionState::CONNECTED)
+        {
+            // The lost connection is reported on the next sync
+            return 0;
+        }
+
+        int64_t ticks = timers->nextExpiry();
+
+        if (ticks < 0)
+        {
+            return -1;
+        }
+
+        // The client's own wheel has not yet been advanced by the time since the last sync
+        if (timers == &ownTimers)
+        {
+            uint64_t pending = currentMicroseconds() - lastExecutionTime;
+            uint64_t remaining = (uint64_t)ticks * 1000;
+
+            ticks = (remaining > pending) ? (remaining - pending + 999) / 1000 : 0;
+        }
+
+        return (ticks > INT32_MAX) ? INT32_MAX : (int32_t)ticks;
+    }
+
+    void MqttClient::setTimerWheel(TimerWheel *wheel)
+    {
+        TimerWheel *previous = timers;
+        timers = (wheel != NULL) ? wheel : &ownTimers;
+
+        // Pending deadlines keep the time they had left
+        auto move = [&](Timer &timer)
+        {
+            if (timer.scheduled())
+            {
+                uint64_t remaining = timer.getDeadline() - previous->getTime();
+                timers->schedule(timer, (timer.getDeadline() > previous->getTime()) ? remaining : 0);
+            }
+        };
+
+        for (Timer *timer : {&clientKeepAliveTimer, &serverKeepAliveTimer, &connectTimer, &reconnectTimer})
+        {
+            move(*timer);
+        }
+
+        for (list<QueuedPublish> &queue : outboundQueues)
+        {
+            for (QueuedPublish &entry : queue)
+            {
+                move(entry.expiryTimer);
+            }
+        }
+    }
+
+    const MqttClientStats &MqttClient::getStats()
+    {
+        return stats;
+    }
+
+    int MqttClient::addLatencyTopicPrefix(const char *prefix, uint16_t length)
+    {
+        topicLatencies.emplace_back();
+        topicLatencies.back().prefix.assign(prefix, length);
+        return topicLatencies.size() - 1;
+    }
+
+    const LatencyHistogram *MqttClient::getDeliveryLatency(QoS qos, int prefix)
+    {
+        if (qos == +QoS::ZERO || prefix >= (int)topicLatencies.size())
+        {
+            return NULL;
+        }
+
+        if (prefix < 0)
+        {
+            return &deliveryLatency[qos._to_integral() - 1];
+        }
+
+        auto item = topicLatencies.begin();
+        advance(item, prefix);
+        return &item->histograms[qos._to_integral() - 1];
+    }
+
+    DeliveryTiming MqttClient::startDelivery(QoS qos, const char *topic, size_t length)
+    {
+        DeliveryTiming timing = {0, -1};
+
+        if (qos == +QoS::ZERO)
+        {
+            return timing;
+        }
+
+        int16_t index = 0;
+
+        for (TopicLatency &latency : topicLatencies)
+        {
+            if (length >= latency.prefix.size() && memcmp(topic, latency.prefix.data(), latency.prefix.size()) == 0)
+            {
+                timing.prefix = index;
+                break;
+            }
+            index++;
+        }
+
+        timing.sentTime = currentMicroseconds();
+
+        return timing;
+    }
+
+    void MqttClient::recordDelivery(uint16_t token, QoS qos)
+    {
+        auto position = find(clientTokens.begin(), clientTokens.end(), token);
+        DeliveryTiming &timing = clientTokenTimings[position - clientTokens.begin()];
+        uint32_t latency = currentMicroseconds() - timing.sentTime;
+
+        deliveryLatency[qos._to_integral() - 1].record(latency);
+
+        if (timing.prefix >= 0)
+        {
+            auto item = topicLatencies.begin();
+            advance(item, timing.prefix);
+            item->histograms[qos._to_integral() - 1].record(latency);
+        }
+    }
+
+    uint16_t MqttClient::publish(EncodedString &topic, Payload &payload, QoS qos, bool retain, const PublishOptions &options)
     {
         if (!connected())
         {
             return -1;
         }
 
-        Publish publishPacket;
+        // The packet is written or encoded into the queue before returning, so the caller's payload can be
+        // referenced rather than copied
+        return publish(topic, Payload::wrap(payload.getData(), payload.size()), qos, retain, options);
+    }
+
+    uint16_t MqttClient::publish(EncodedString &topic, Payload &&payload, QoS qos, bool retain, const PublishOptions &options)
+    {
+        if (!connected() || !topic.validateTopicName())
+        {
+            return -1;
+        }
+
+        uint32_t allocations = getAllocationCount();
 
+        publishPacket.reset(PacketId::PUBLISH);
         publishPacket.setTopic(topic);
-        publishPacket.setPayload(payload);
+        publishPacket.setPayload(std::move(payload));
         publishPacket.setQos(qos);
         publishPacket.setRetain(retain);
 
+        uint32_t expiry = (options.messageExpiry > 0) ? options.messageExpiry : messageExpiryInterval;
+        bool expires = expiry > 0 && expiry != MESSAGE_EXPIRY_NEVER;
+
+        if (expires)
+        {
+            Property *property = publishPacket.getProperties().emplaceProperty(MESSAGE_EXPIRY_INTERVAL);
+
+            if (property == NULL)
+            {
+                // The arena has no memory left, the default allocator reports its own failure
+                property = new MessageExpiryIntervalProperty();
+                publishPacket.getProperties().addProperty(property);
+            }
+
+            ((MessageExpiryIntervalProperty *)property)->setValue(expiry);
+        }
+
         uint16_t packetIdentifier = getPacketIdentifier();
 
         if (qos != +QoS::ZERO)
@@ -806,8 +1421,73 @@ namespace CppMqtt
             publishPacket.setPacketIdentifier(packetIdentifier);
         }
 
-        auto result = sendPacket(&publishPacket);
+        DeliveryTiming timing = startDelivery(qos, topic.data, topic.length);
+
+        sendQueued();
+
+        if (congested())
+        {
+            sendBuffer.reset(publishPacket.totalSize());
+            publishPacket.push(sendBuffer);
+
+            // The expiry is the only property, so its value directly precedes the payload
+            size_t expiryOffset = expires ? sendBuffer.getLength() - publishPacket.getPayload().size() - sizeof(uint32_t) : 0;
+
+            queuePublish(sendBuffer, expiryOffset, expiry, qos, packetIdentifier, timing, options.priority);
+        }
+        else
+        {
+            auto result = sendPacket(&publishPacket);
+
+            publishSent(qos, packetIdentifier, result, timing);
+        }
+
+        // The payload is not kept past the publish
+        publishPacket.setPayload(Payload());
+        stats.addAllocations(getAllocationCount() - allocations);
+
+        return packetIdentifier;
+    }
+
+    uint16_t MqttClient::publish(PreparedPublish &prepared, Payload &payload, PublishPriority priority)
+    {
+        if (!connected() || !prepared.validate(payload))
+        {
+            return -1;
+        }
+
+        uint32_t allocations = getAllocationCount();
+        uint16_t packetIdentifier = getPacketIdentifier();
+
+        // The interval the publish was prepared with takes precedence over the client default
+        uint32_t expiry = (prepared.getMessageExpiry() > 0) ? prepared.getMessageExpiry() : messageExpiryInterval;
+        bool expires = expiry > 0 && expiry != MESSAGE_EXPIRY_NEVER;
+        size_t expiryOffset = 0;
+
+        sendBuffer.reset(prepared.totalSize(payload, expires ? expiry : 0));
+        prepared.push(sendBuffer, packetIdentifier, payload, expires ? expiry : 0, expiryOffset);
+
+        DeliveryTiming timing = startDelivery(prepared.getQos(), prepared.getTopic(), prepared.getTopicLength());
+
+        sendQueued();
+
+        if (congested())
+        {
+            queuePublish(sendBuffer, expires ? expiryOffset : 0, expiry, prepared.getQos(), packetIdentifier, timing, priority);
+        }
+        else
+        {
+            auto result = write(sendBuffer.getBuffer(), sendBuffer.getLength());
+
+            publishSent(prepared.getQos(), packetIdentifier, result, timing);
+        }
+        stats.addAllocations(getAllocationCount() - allocations);
 
+        return packetIdentifier;
+    }
+
+    void MqttClient::publishSent(QoS qos, uint16_t packetIdentifier, int result, DeliveryTiming timing)
+    {
         if (qos == +QoS::ZERO)
         {
             // TODO: Implement feedback from when the TCP Client succeeds in sending messages
@@ -819,12 +1499,15 @@ namespace CppMqtt
             {
                 qosZeroFailed.push_back(packetIdentifier);
             }
+
+            // QoS 0 publishes are held until their delivery is reported on the next sync
+            updateQueueDepth();
         }
         else
         {
             clientTokens.push_back(packetIdentifier);
+            clientTokenTimings.push_back(timing);
+            stats.setInflight(clientTokens.size());
         }
-
-        return packetIdentifier;
     }
 }
\ No newline at end of file
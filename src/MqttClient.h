@@ -42,9 +42,18 @@
 #include "packets/ConnectAcknowledge.h"
 #include "packets/Disconnect.h"
 #include <functional>
+#include <list>
 #include <map>
+#include <span>
+#include <string>
+#include <string_view>
 #include "Client.h"
+#include "MqttClientStats.h"
+#include "LatencyHistogram.h"
+#include "Clock.h"
+#include "utils/TimerWheel.h"
 #include "packets/PacketUtility.h"
+#include "packets/PacketTemplates.h"
 #include "types/Common.h"
 #include "utils/enum.h"
 
@@ -69,30 +78,145 @@ namespace CppMqtt
                 CONNECTED,
                 CONNECTING)
 
+    // Order publishes are written in when queued, control and acknowledgement packets always go first
+    BETTER_ENUM(PublishPriority, uint8_t,
+                BULK,
+                NORMAL,
+                URGENT)
+
+#define PUBLISH_PRIORITIES 3
+
     /**
-     * @brief A handler for receiving callbacks from the MQTT Client
+     * @brief Timing information collected by the auto reconnect engine
+     * All latencies are in milliseconds, measured from the loss of the connection
+     * until the broker acknowledged the new connection
+     */
+    typedef struct
+    {
+        uint32_t attempts;
+        uint32_t reconnects;
+        uint32_t lastLatency;
+        uint32_t maximumLatency;
+        uint64_t totalLatency;
+    } ReconnectStatistics;
+
+    /**
+     * @brief When an unacknowledged publish was written, and the topic prefix its latency is recorded against
+     */
+    typedef struct
+    {
+        uint32_t sentTime;
+        int16_t prefix;
+    } DeliveryTiming;
+
+    /**
+     * @brief Delivery latency histograms for publishes to topics starting with a prefix
+     */
+    class TopicLatency
+    {
+    public:
+        std::string prefix;
+        // QoS 1 and QoS 2
+        LatencyHistogram histograms[2];
+    };
+
+    /**
+     * @brief Details of a received message
+     * Only valid for the duration of the callback it was passed to
+     */
+    typedef struct
+    {
+        QoS qos;
+        bool retain;
+        bool duplicate;
+        Token token;
+        Properties *properties;
+    } MessageMetadata;
+
+// Sends no Message Expiry Interval, the message never expires
+#define MESSAGE_EXPIRY_NEVER 0xFFFFFFFF
+// Reported to onDeliveryFailure when a queued publish expires before it is written
+#define MESSAGE_EXPIRED -1
+
+    typedef struct
+    {
+        // Seconds the message is kept for, 0 uses the client's default
+        uint32_t messageExpiry = 0;
+        PublishPriority priority = PublishPriority::NORMAL;
+    } PublishOptions;
+
+    /**
+     * @brief A publish waiting for a congested transport
+     * Held encoded so borrowed payloads are not referenced after publish returns.
+     */
+    class QueuedPublish
+    {
+    public:
+        vector<uint8_t> data;
+        // Position of the Message Expiry Interval value in data, 0 if the message does not expire
+        size_t expiryOffset = 0;
+        uint32_t expiry = 0;
+        // Microseconds from the Clock
+        uint64_t queuedTime = 0;
+        Token token = 0;
+        QoS qos = QoS::ZERO;
+        PublishPriority priority = PublishPriority::NORMAL;
+        DeliveryTiming timing = {0, -1};
+        Timer expiryTimer;
+    };
+
+    /**
+     * @brief Callbacks shared by every version of the client handler
      *
      */
-    class MqttClientHandler
+    class MqttClientHandlerBase
     {
     public:
+        virtual ~MqttClientHandlerBase(){};
         virtual void onConnectionSuccess() = 0;
         virtual void onConnectionFailure(int reasonCode) = 0;
         virtual void onDisconnection(ReasonCode reasonCode) = 0;
-        virtual void onMessage(EncodedString &topic, Payload &payload) = 0;
         virtual void onDeliveryComplete(Token token) = 0;
         virtual void onDeliveryFailure(Token token, int reasonCode) = 0;
+    };
+
+    /**
+     * @brief A handler for receiving callbacks from the MQTT Client
+     *
+     */
+    class MqttClientHandler : public MqttClientHandlerBase
+    {
+    public:
+        virtual void onMessage(EncodedString &topic, Payload &payload) = 0;
         virtual void onSubscribeResult(Token token, vector<uint8_t> reasonCodes) = 0;
         virtual void onUnsubscribeResult(Token token, vector<uint8_t> reasonCodes) = 0;
     };
 
+    /**
+     * @brief A handler for receiving callbacks from the MQTT Client without copying packet data
+     * Topics, payloads, reason codes and properties are views into the received packet and are only
+     * valid for the duration of the callback, copy them if they are needed afterwards.
+     */
+    class MqttClientHandlerV2 : public MqttClientHandlerBase
+    {
+    public:
+        virtual void onMessage(string_view topic, span<const uint8_t> payload, const MessageMetadata &metadata) = 0;
+        virtual void onSubscribeResult(Token token, span<const uint8_t> reasonCodes) = 0;
+        virtual void onUnsubscribeResult(Token token, span<const uint8_t> reasonCodes) = 0;
+    };
+
     class MqttClient
     {
     private:
         WillProperties *willProperties;
         Connect connectPacket;
+        // Reused for each publish, so its properties keep their memory between publishes
+        Publish publishPacket;
         bool awaitingPingResponse = false;
+        uint32_t pingSentTime = 0;
         map<Token, Publish *> publishQueue;
+        // Released queue entries, reused with their packets so inbound QoS 2 does not allocate
+        vector<map<Token, Publish *>::node_type> spareQueueEntries;
         // Original idea was to use a hashmap of responses to packets.
         // However hard coded responses would be more practical
         map<uint8_t, packetResponse> responses;
@@ -103,19 +227,28 @@ namespace CppMqtt
         EncodedString username;
         EncodedString password;
 
-        MqttClientHandler *handler = NULL;
+        // Receives the shared callbacks, set alongside the versioned handler below
+        MqttClientHandlerBase *handler = NULL;
+        MqttClientHandler *handlerV1 = NULL;
+        MqttClientHandlerV2 *handlerV2 = NULL;
 
         uint32_t willDelayInterval;
-        uint32_t messageExpiryInterval;
+        // Default for publishes, 0 if messages do not expire
+        uint32_t messageExpiryInterval = 0;
         uint32_t sessionExpiryInterval;
         uint16_t receiveMaximum;
         uint32_t maximumPacketSize;
         uint16_t topicAliasMaximum;
         uint16_t packetIdentifier = 0;
 
-        /* Timers */
-        uint32_t clientKeepAliveTimeRemaining = 0;
-        uint32_t serverKeepAliveTimeRemaining = 0;
+        /* Timers, in milliseconds */
+        TimerWheel ownTimers;
+        // The client's own wheel, or one shared with other clients
+        TimerWheel *timers = &ownTimers;
+        Timer clientKeepAliveTimer{[this]() { clientKeepAliveExpired(); }};
+        Timer serverKeepAliveTimer{[this]() { serverKeepAliveExpired(); }};
+        Timer connectTimer{[this]() { connectTimedOut(); }};
+        Timer reconnectTimer{[this]() { reconnect(); }};
 
         uint8_t state = 0;
 
@@ -124,20 +257,39 @@ namespace CppMqtt
         char *address = nullptr;
         int port = -1;
         uint32_t connectTimeout = -1;
-        uint32_t reconnectTimer = 0;
         bool attemptingReconnect = false;
-
-#if defined(PICO)
-        uint64_t lastExecutionTime = 0;
-#elif defined(ARDUINO)
-        uint32_t lastExecutionTime = 0;
-#elif defined(__linux__)
-        std::chrono::_V2::system_clock::time_point lastExecutionTime;
-#endif
+        uint32_t maximumReconnectDelay = 60000;
+        uint32_t reconnectAttempts = 0;
+        uint32_t reconnectElapsed = 0;
+        uint32_t reconnectSeed = 0;
+        ReconnectStatistics reconnectStatistics = {};
+        // CONNECT packet serialized on first use, reused by automatic reconnects
+        vector<uint8_t> serializedConnect;
+        // Recycled packets for the receive path
+        PacketPool packetPool;
+        // Outbound packets are serialized here, grown to the largest packet sent
+        PacketBuffer sendBuffer;
+        MqttClientStats stats;
+
+        // Microseconds from the Clock, only advanced by whole milliseconds so frequent syncs do not lose time
+        uint64_t lastExecutionTime = currentMicroseconds();
         vector<uint16_t> qosZeroFailed;
         vector<uint16_t> qosZeroSuccess;
         vector<uint16_t> clientTokens;
+        // Timing of each publish in clientTokens, kept at the same position
+        vector<DeliveryTiming> clientTokenTimings;
+        // Microseconds from writing a publish to its PUBACK or PUBCOMP, for QoS 1 and QoS 2
+        LatencyHistogram deliveryLatency[2];
+        // A list so histograms are never moved while being read
+        list<TopicLatency> topicLatencies;
         vector<uint16_t> serverTokens;
+        // Bytes of packets the transport has not accepted yet, written before anything else. Control and
+        // acknowledgement packets are added here directly, so they only wait for the packet being written
+        vector<uint8_t> unsent;
+        size_t unsentPosition = 0;
+        // Publishes made while the transport was congested, a lane for each priority, oldest first
+        list<QueuedPublish> outboundQueues[PUBLISH_PRIORITIES];
+        size_t queuedPublishes = 0;
 
         template <typename... T>
         void addSubscribePayload(Subscribe &packet, SubscribePayload &payload, T &...args);
@@ -157,7 +309,7 @@ namespace CppMqtt
         Packet *readNextPacket();
         void ping();
         void pingResponse();
-        void messageReceived(EncodedString &topic, Payload &payload);
+        void messageReceived(Publish *packet);
         void connectionAcknowledged(ConnectAcknowledge *packet);
 
         void onPublish(Publish *packet);
@@ -168,6 +320,54 @@ namespace CppMqtt
 
         void mqttConnect();
 
+        /**
+         * @brief Tracks the delivery of a sent publish packet
+         *
+         * @param qos The QOS the packet was sent with
+         * @param packetIdentifier The token of the publish
+         * @param result The result of writing the packet to the communication client
+         */
+        void publishSent(QoS qos, uint16_t packetIdentifier, int result, DeliveryTiming timing);
+
+        /**
+         * @brief Timestamps a publish about to be written
+         *
+         * @param qos
+         * @param topic The topic name, matched against the latency topic prefixes
+         * @param length
+         * @return DeliveryTiming
+         */
+        DeliveryTiming startDelivery(QoS qos, const char *topic, size_t length);
+        /**
+         * @brief Records the delivery latency of a publish that has been acknowledged
+         *
+         * @param token
+         * @param qos
+         */
+        void recordDelivery(uint16_t token, QoS qos);
+
+        /**
+         * @brief Starts the auto reconnect engine after the connection has been lost
+         * Does nothing if auto reconnect is disabled
+         */
+        void scheduleReconnect();
+
+        /**
+         * @brief Attempts to reopen the communication client using the stored address and port
+         * Called when the reconnect timer expires
+         */
+        void reconnect();
+
+        /**
+         * @brief Calculates the delay before the next reconnect attempt
+         * The delay grows exponentially from the auto reconnect value up to the maximum reconnect delay.
+         * Half of the delay is randomised so a fleet of clients does not reconnect at the same instant
+         *
+         * @return uint32_t delay in milliseconds
+         */
+        uint32_t nextReconnectDelay();
+        void seedReconnectJitter();
+
         ConnectionState getConnectionState();
 
         /**
@@ -201,12 +401,75 @@ namespace CppMqtt
         int sendPacket(Packet *packet);
 
         /**
-         * @brief Updates the keep alive period timers
-         * Will handle disconnections or ping requests based off inactivity
+         * @brief Returns whether a publish has to wait behind unsent data or a congested transport
+         *
+         * @return true
+         * @return false
+         */
+        bool congested();
+        /**
+         * @brief Writes what the transport will take of a partially written packet
+         *
+         * @return true If nothing is left unsent
+         * @return false
+         */
+        bool flushUnsent();
+        /**
+         * @brief Writes queued publishes until the transport is congested, dropping expired ones
+         */
+        void sendQueued();
+        void queuePublish(PacketBuffer &buffer, size_t expiryOffset, uint32_t expiry, QoS qos, Token token, DeliveryTiming timing,
+                          PublishPriority priority);
+        void expireQueued(list<QueuedPublish>::iterator entry);
+        /**
+         * @brief Sets the queue depth statistic from the queued publishes and unreported QoS 0 publishes
+         */
+        void updateQueueDepth();
+        bool isQueued(uint16_t token);
+
+        /**
+         * @brief Writes an encoded packet to the client, counting it in the statistics
+         *
+         * @param data The encoded packet
+         * @param length
+         * @return int The amount of bytes written
+         */
+        int write(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Sends a pre-encoded packet to the client
          *
-         * @param timeElapsed
+         * @param packet
          */
-        void updateKeepAlivePeriod(uint32_t timeElapsed);
+        template <size_t N>
+        int sendTemplate(const PacketTemplate<N> &packet)
+        {
+            return write(packet.bytes, N);
+        }
+
+        /**
+         * @brief Sends a ping once the keep alive interval passes
+         */
+        void clientKeepAliveExpired();
+        /**
+         * @brief Disconnects once nothing has been received from the server for one and a half keep alive intervals
+         */
+        void serverKeepAliveExpired();
+        /**
+         * @brief Stops the communication client and returns to the disconnected state
+         */
+        void closeConnection();
+        /**
+         * @brief Gives up on a communication client that has not connected within the connect timeout
+         */
+        void connectTimedOut();
+        /**
+         * @brief Schedules a keep alive timer when keep alive is enabled
+         *
+         * @param timer
+         * @param interval The keep alive interval scaled to milliseconds
+         */
+        void scheduleKeepAlive(Timer &timer, uint32_t interval);
 
         void setConnectionState(ConnectionState state);
         void setClientConnectionState(ConnectionState state);
@@ -218,7 +481,7 @@ namespace CppMqtt
          *
          * @return uint32_t elapsed time in milliseconds
          */
-        uint32_t getElapsed();
+        virtual uint32_t getElapsed();
 
         template <typename CommunicationClient>
         MqttClient();
@@ -226,9 +489,24 @@ namespace CppMqtt
     public:
         MqttClient();
         MqttClient(Client *client);
-        ~MqttClient();
+        virtual ~MqttClient();
         int setWill(WillProperties *);
+        /**
+         * @brief Connects the communication client, the MQTT connection is made on the following syncs
+         * With auto reconnect enabled a failed attempt is retried with the reconnect backoff.
+         *
+         * @param address
+         * @param port
+         * @param connectTimeout milliseconds to wait for the connection
+         * @return int 0 on success or if already connecting, -1 if the communication client failed to connect
+         */
         int connect(const char *address, int port, uint32_t connectTimeout);
+        /**
+         * @brief Sends DISCONNECT and stops the communication client, the client does not reconnect
+         *
+         * @param reasonCode
+         * @return int 0 on success, -1 if not connected
+         */
         int disconnect(ReasonCode reasonCode);
         int subscribe(SubscribePayload &payload...);
         int unsubscribe(UnsubscribePayload &payload...);
@@ -238,7 +516,44 @@ namespace CppMqtt
         void setCredentials(EncodedString name, EncodedString password);
         bool connected();
 
+        /* Event loop integration */
+        /**
+         * @brief Returns the transport's descriptor for waiting on with poll, epoll or an event loop
+         *
+         * @return int -1 if the transport has none, the client then has to be synced on a timer
+         */
+        int getFileDescriptor();
+        /**
+         * @brief Returns whether the client should be synced when its descriptor becomes readable
+         *
+         * @return true
+         * @return false
+         */
+        bool wantsRead();
+        /**
+         * @brief Returns whether the client should be synced when its descriptor becomes writable
+         *
+         * @return true
+         * @return false
+         */
+        bool wantsWrite();
+        /**
+         * @brief Returns how long the client can wait for its descriptor before it has to be synced
+         * Covers keep alive, connect timeouts and reconnects, rounded up so the deadline has passed when synced.
+         * With a shared wheel this is the next deadline of any client on it.
+         *
+         * @return int32_t milliseconds, 0 if work is already pending, -1 if nothing is scheduled
+         */
+        int32_t getTimeout();
+
         void setHandler(MqttClientHandler *hander);
+        /**
+         * @brief Sets a handler receiving views of packet data instead of copies
+         * Replaces any handler set previously
+         *
+         * @param hander
+         */
+        void setHandler(MqttClientHandlerV2 *hander);
 
         /* Utilities */
         /**
@@ -262,6 +577,15 @@ namespace CppMqtt
         void setReceiveMaximum(uint16_t value);
         uint32_t getMaximumPacketSize();
         void setMaximumPacketSize(uint32_t value);
+        /**
+         * @brief Sets the Message Expiry Interval sent with publishes that do not set their own
+         * Publishes still queued when their interval passes are dropped, and the interval sent with a queued
+         * publish is reduced by the time it waited.
+         *
+         * @param value seconds, 0 if messages do not expire
+         */
+        void setMessageExpiryInterval(uint32_t value);
+        uint32_t getMessageExpiryInterval();
         uint16_t getTopicAliasMaximum();
         void setTopicAliasMaximum(uint16_t value);
         EncodedString getUserName();
@@ -269,8 +593,56 @@ namespace CppMqtt
         EncodedString getPassword();
         void setPassword(EncodedString value);
 
+        /**
+         * @brief Enables automatic reconnects when the connection is lost
+         *
+         * @param value The initial delay in milliseconds before reconnecting. A negative value disables auto reconnect
+         */
         void setAutoReconnect(int32_t value);
         int getAutoReconnect();
+        /**
+         * @brief Sets the cap applied to the exponential reconnect backoff
+         *
+         * @param value maximum delay in milliseconds
+         */
+        void setMaximumReconnectDelay(uint32_t value);
+        uint32_t getMaximumReconnectDelay();
+        ReconnectStatistics getReconnectStatistics();
+        /**
+         * @brief Schedules the client's deadlines on a wheel shared with other clients
+         * The owner of the wheel advances it in milliseconds, so timer upkeep is shared rather than done by
+         * every client on every sync. Must be set while disconnected.
+         *
+         * @param wheel The shared wheel, NULL returns to the client's own wheel
+         */
+        void setTimerWheel(TimerWheel *wheel);
+        /**
+         * @brief Returns the statistics of the client
+         * The statistics may be read from any thread while the client is running
+         *
+         * @return const MqttClientStats&
+         */
+        const MqttClientStats &getStats();
+        /**
+         * @brief Records delivery latency separately for publishes to topics starting with a prefix
+         * Prefixes should be added before the client starts publishing, a publish is recorded against
+         * the first prefix it matches
+         *
+         * @param prefix
+         * @param length
+         * @return int The identifier of the prefix
+         */
+        int addLatencyTopicPrefix(const char *prefix, uint16_t length);
+        /**
+         * @brief Returns the histogram of delivery latencies in microseconds, from writing a publish
+         * until its PUBACK or PUBCOMP was received
+         * The histogram may be read from any thread while the client is running
+         *
+         * @param qos QoS::ONE or QoS::TWO
+         * @param prefix A prefix identifier from addLatencyTopicPrefix, -1 for all publishes
+         * @return const LatencyHistogram* The histogram, NULL for QoS 0 or an unknown prefix
+         */
+        const LatencyHistogram *getDeliveryLatency(QoS qos, int prefix = -1);
 
         /* Publish Actions */
         /**
@@ -279,9 +651,32 @@ namespace CppMqtt
          * @param topic The topic to publish the payload with
          * @param payload The payload to publish
          * @param qos The QOS of the payload to publish
-         * @return uint16_t The unique token used to identify a publish packet
+         * @param options Message expiry and priority for the publish
+         * @return uint16_t The unique token used to identify a publish packet, -1 if not connected or the topic is not a valid topic name
+         */
+        uint16_t publish(EncodedString &topic, Payload &payload, QoS qos, bool retain = false, const PublishOptions &options = {});
+        /**
+         * @brief Publish a payload over MQTT, handing the payload over to the client
+         * Buffers created with a release callback are released once the packet has been written
+         *
+         * @param topic The topic to publish the payload with
+         * @param payload The payload to publish
+         * @param qos The QOS of the payload to publish
+         * @param options Message expiry and priority for the publish
+         * @return uint16_t The unique token used to identify a publish packet, -1 if not connected or the topic is not a valid topic name
+         */
+        uint16_t publish(EncodedString &topic, Payload &&payload, QoS qos, bool retain = false, const PublishOptions &options = {});
+        /**
+         * @brief Publish a payload over MQTT using a pre-encoded topic and properties
+         * The default Message Expiry Interval is added when the properties have none, and queued publishes expire either way
+         *
+         * @param prepared The prepared topic, QOS and properties to publish with
+         * @param payload The payload to publish
+         * @param priority The lane the publish waits in if the transport is congested
+         * @return uint16_t The unique token used to identify a publish packet, -1 if not connected, or the topic name
+         * or a payload marked as UTF-8 is not valid
          */
-        uint16_t publish(EncodedString &topic, Payload &payload, QoS qos, bool retain = false);
+        uint16_t publish(PreparedPublish &prepared, Payload &payload, PublishPriority priority = PublishPriority::NORMAL);
 
         /* Subscribe Actions */
     };
@@ -0,0 +1,241 @@
+/*
+ * File: MqttClientStats.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#include "MqttClientStats.h"
+#include <stdio.h>
+#include <stdarg.h>
+
+using namespace CppMqtt;
+
+#define PACKET_TYPE_SHIFT 4
+
+static const char *const PACKET_TYPE_NAMES[PACKET_TYPE_COUNT] = {
+    "reserved", "connect", "connack", "publish", "puback", "pubrec", "pubrel", "pubcomp",
+    "subscribe", "suback", "unsubscribe", "unsuback", "pingreq", "pingresp", "disconnect", "auth"};
+
+void MqttClientStats::packetReceived(uint8_t fixedHeader)
+{
+    add(packetsReceived[fixedHeader >> PACKET_TYPE_SHIFT], 1);
+}
+
+void MqttClientStats::packetSent(uint8_t fixedHeader, size_t bytes)
+{
+    add(bytesSent, bytes);
+    add(packetsSent[fixedHeader >> PACKET_TYPE_SHIFT], 1);
+}
+
+void MqttClientStats::setInflight(uint32_t value)
+{
+    inflight.store(value, std::memory_order_relaxed);
+
+    if (value > peakInflight.load(std::memory_order_relaxed))
+    {
+        peakInflight.store(value, std::memory_order_relaxed);
+    }
+}
+
+StatValue MqttClientStats::getPacketsReceived(uint8_t packetType) const
+{
+    return packetsReceived[(packetType >> PACKET_TYPE_SHIFT) % PACKET_TYPE_COUNT].load(std::memory_order_relaxed);
+}
+
+StatValue MqttClientStats::getPacketsSent(uint8_t packetType) const
+{
+    return packetsSent[(packetType >> PACKET_TYPE_SHIFT) % PACKET_TYPE_COUNT].load(std::memory_order_relaxed);
+}
+
+MqttClientStatsSnapshot MqttClientStats::snapshot() const
+{
+    MqttClientStatsSnapshot stats;
+
+    stats.bytesReceived = getBytesReceived();
+    stats.bytesSent = getBytesSent();
+
+    for (int i = 0; i < PACKET_TYPE_COUNT; i++)
+    {
+        stats.packetsReceived[i] = packetsReceived[i].load(std::memory_order_relaxed);
+        stats.packetsSent[i] = packetsSent[i].load(std::memory_order_relaxed);
+    }
+
+    stats.inflight = getInflight();
+    stats.peakInflight = getPeakInflight();
+    stats.queueDepth = getQueueDepth();
+    stats.reconnects = getReconnects();
+    stats.pingRoundTrip = getPingRoundTrip();
+    stats.parseErrors = getParseErrors();
+    stats.allocations = getAllocations();
+
+    return stats;
+}
+
+/**
+ * @brief Appends formatted text to a buffer, tracking the space used
+ *
+ * @return true If the text fit in the buffer
+ */
+static bool append(char *buffer, size_t length, size_t &position, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    int written = vsnprintf(buffer + position, length - position, format, arguments);
+    va_end(arguments);
+
+    if (written < 0 || (size_t)written >= length - position)
+    {
+        return false;
+    }
+
+    position += written;
+    return true;
+}
+
+int CppMqtt::exportPrometheus(const MqttClientStatsSnapshot &stats, char *buffer, size_t length)
+{
+    size_t position = 0;
+
+    if (length == 0)
+    {
+        return -1;
+    }
+
+    const struct
+    {
+        const char *name;
+        const char *type;
+        const char *help;
+        StatValue value;
+    } metrics[] = {
+        {"mqtt_client_received_bytes_total", "counter", "Bytes received from the broker", stats.bytesReceived},
+        {"mqtt_client_sent_bytes_total", "counter", "Bytes sent to the broker", stats.bytesSent},
+        {"mqtt_client_inflight_messages", "gauge", "Publishes waiting for acknowledgement", stats.inflight},
+        {"mqtt_client_inflight_messages_peak", "gauge", "Most publishes waiting for acknowledgement at once", stats.peakInflight},
+        {"mqtt_client_queue_depth", "gauge", "Outbound messages held by the client", stats.queueDepth},
+        {"mqtt_client_reconnects_total", "counter", "Automatic reconnects", stats.reconnects},
+        {"mqtt_client_ping_round_trip_microseconds", "gauge", "Round trip time of the last ping", stats.pingRoundTrip},
+        {"mqtt_client_parse_errors_total", "counter", "Malformed packets received", stats.parseErrors},
+        {"mqtt_client_allocations_total", "counter", "Heap allocations made by the library", stats.allocations},
+    };
+
+    for (auto &metric : metrics)
+    {
+        if (!append(buffer, length, position, "# HELP %s %s\n# TYPE %s %s\n%s %llu\n", metric.name, metric.help,
+                    metric.name, metric.type, metric.name, (unsigned long long)metric.value))
+        {
+            return -1;
+        }
+    }
+
+    const struct
+    {
+        const char *name;
+        const char *help;
+        const StatValue *values;
+    } packets[] = {
+        {"mqtt_client_received_packets_total", "Packets received from the broker", stats.packetsReceived},
+        {"mqtt_client_sent_packets_total", "Packets sent to the broker", stats.packetsSent},
+    };
+
+    for (auto &metric : packets)
+    {
+        if (!append(buffer, length, position, "# HELP %s %s\n# TYPE %s counter\n", metric.name, metric.help, metric.name))
+        {
+            return -1;
+        }
+
+        // Type 0 is reserved and never counted
+        for (int i = 1; i < PACKET_TYPE_COUNT; i++)
+        {
+            if (!append(buffer, length, position, "%s{type=\"%s\"} %llu\n", metric.name, PACKET_TYPE_NAMES[i],
+                        (unsigned long long)metric.values[i]))
+            {
+                return -1;
+            }
+        }
+    }
+
+    return position;
+}
+
+int CppMqtt::exportJson(const MqttClientStatsSnapshot &stats, char *buffer, size_t length)
+{
+    size_t position = 0;
+
+    if (length == 0)
+    {
+        return -1;
+    }
+
+    if (!append(buffer, length, position,
+                "{\"bytesReceived\":%llu,\"bytesSent\":%llu,\"inflight\":%llu,\"peakInflight\":%llu,"
+                "\"queueDepth\":%llu,\"reconnects\":%llu,\"pingRoundTrip\":%llu,\"parseErrors\":%llu,\"allocations\":%llu",
+                (unsigned long long)stats.bytesReceived, (unsigned long long)stats.bytesSent,
+                (unsigned long long)stats.inflight, (unsigned long long)stats.peakInflight,
+                (unsigned long long)stats.queueDepth, (unsigned long long)stats.reconnects,
+                (unsigned long long)stats.pingRoundTrip, (unsigned long long)stats.parseErrors,
+                (unsigned long long)stats.allocations))
+    {
+        return -1;
+    }
+
+    const char *names[] = {"packetsReceived", "packetsSent"};
+    const StatValue *values[] = {stats.packetsReceived, stats.packetsSent};
+
+    for (int j = 0; j < 2; j++)
+    {
+        if (!append(buffer, length, position, ",\"%s\":{", names[j]))
+        {
+            return -1;
+        }
+
+        for (int i = 1; i < PACKET_TYPE_COUNT; i++)
+        {
+            if (!append(buffer, length, position, "%s\"%s\":%llu", (i > 1) ? "," : "", PACKET_TYPE_NAMES[i],
+                        (unsigned long long)values[j][i]))
+            {
+                return -1;
+            }
+        }
+
+        if (!append(buffer, length, position, "}"))
+        {
+            return -1;
+        }
+    }
+
+    if (!append(buffer, length, position, "}"))
+    {
+        return -1;
+    }
+
+    return position;
+}
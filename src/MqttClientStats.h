@@ -0,0 +1,156 @@
+/*
+ * File: MqttClientStats.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#ifndef SRC_MQTTCLIENTSTATS
+#define SRC_MQTTCLIENTSTATS
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#define PACKET_TYPE_COUNT 16
+
+namespace CppMqtt
+{
+#if defined(__linux__)
+    typedef uint64_t StatValue;
+#else
+    // 64 bit atomics are not lock free on 32 bit microcontrollers
+    typedef uint32_t StatValue;
+#endif
+
+    /**
+     * @brief A copy of the statistics of a client taken at a single point in time
+     * Packet counts are indexed by the packet type, the upper 4 bits of the fixed header
+     */
+    typedef struct
+    {
+        StatValue bytesReceived;
+        StatValue bytesSent;
+        StatValue packetsReceived[PACKET_TYPE_COUNT];
+        StatValue packetsSent[PACKET_TYPE_COUNT];
+        StatValue inflight;
+        StatValue peakInflight;
+        StatValue queueDepth;
+        StatValue reconnects;
+        StatValue pingRoundTrip;
+        StatValue parseErrors;
+        StatValue allocations;
+    } MqttClientStatsSnapshot;
+
+    /**
+     * @brief Counters describing the activity of a client
+     * Only the thread running the client writes the counters, any other thread may read them at any time
+     * without locking. Each counter is read atomically, but counters are not updated together, so a snapshot
+     * can be a few packets out of step between counters.
+     */
+    class MqttClientStats
+    {
+    private:
+        std::atomic<StatValue> bytesReceived{0};
+        std::atomic<StatValue> bytesSent{0};
+        std::atomic<StatValue> packetsReceived[PACKET_TYPE_COUNT] = {};
+        std::atomic<StatValue> packetsSent[PACKET_TYPE_COUNT] = {};
+        std::atomic<StatValue> inflight{0};
+        std::atomic<StatValue> peakInflight{0};
+        std::atomic<StatValue> queueDepth{0};
+        std::atomic<StatValue> reconnects{0};
+        std::atomic<StatValue> pingRoundTrip{0};
+        std::atomic<StatValue> parseErrors{0};
+        std::atomic<StatValue> allocations{0};
+
+        /**
+         * @brief Adds to a counter with a plain load and store
+         * Safe as there is a single writer, and avoids read-modify-write instructions some targets lack
+         */
+        static void add(std::atomic<StatValue> &counter, StatValue value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+    protected:
+    public:
+        /* Writers, only called by the thread running the client */
+        void packetReceived(uint8_t fixedHeader);
+        void addBytesReceived(size_t bytes) { add(bytesReceived, bytes); };
+        void packetSent(uint8_t fixedHeader, size_t bytes);
+        void setInflight(uint32_t value);
+        void setQueueDepth(uint32_t value) { queueDepth.store(value, std::memory_order_relaxed); };
+        void reconnected() { add(reconnects, 1); };
+        /**
+         * @brief Records the time between the last ping request and its response
+         *
+         * @param value The round trip time in microseconds
+         */
+        void setPingRoundTrip(uint32_t value) { pingRoundTrip.store(value, std::memory_order_relaxed); };
+        void parseError() { add(parseErrors, 1); };
+        void addAllocations(uint32_t count) { add(allocations, count); };
+
+        /* Readers, safe from any thread */
+        StatValue getBytesReceived() const { return bytesReceived.load(std::memory_order_relaxed); };
+        StatValue getBytesSent() const { return bytesSent.load(std::memory_order_relaxed); };
+        StatValue getPacketsReceived(uint8_t packetType) const;
+        StatValue getPacketsSent(uint8_t packetType) const;
+        StatValue getInflight() const { return inflight.load(std::memory_order_relaxed); };
+        StatValue getPeakInflight() const { return peakInflight.load(std::memory_order_relaxed); };
+        StatValue getQueueDepth() const { return queueDepth.load(std::memory_order_relaxed); };
+        StatValue getReconnects() const { return reconnects.load(std::memory_order_relaxed); };
+        StatValue getPingRoundTrip() const { return pingRoundTrip.load(std::memory_order_relaxed); };
+        StatValue getParseErrors() const { return parseErrors.load(std::memory_order_relaxed); };
+        StatValue getAllocations() const { return allocations.load(std::memory_order_relaxed); };
+
+        MqttClientStatsSnapshot snapshot() const;
+    };
+
+    /**
+     * @brief Writes a snapshot in the Prometheus text exposition format
+     *
+     * @param stats The snapshot to write
+     * @param buffer The output, null terminated
+     * @param length The size of the output buffer
+     * @return int The amount of characters written, -1 if the buffer is too small
+     */
+    int exportPrometheus(const MqttClientStatsSnapshot &stats, char *buffer, size_t length);
+
+    /**
+     * @brief Writes a snapshot as a JSON object
+     *
+     * @param stats The snapshot to write
+     * @param buffer The output, null terminated
+     * @param length The size of the output buffer
+     * @return int The amount of characters written, -1 if the buffer is too small
+     */
+    int exportJson(const MqttClientStatsSnapshot &stats, char *buffer, size_t length);
+}
+
+#endif /* SRC_MQTTCLIENTSTATS */
@@ -50,12 +50,17 @@
 #include "properties/StringProperty.h"
 #include "properties/VariableByteProperty.h"
 #include "properties/WordProperty.h"
+#include "properties/PropertyArena.h"
 
 using namespace std;
 
 namespace CppMqtt
 {
 
+// Index slots cover identifiers 1 to 42, slot 0 is used by SHARED_SUBSCRIPTION_AVAILABLE
+#define PROPERTY_INDEX_SIZE 43
+#define PROPERTY_INDEX_NONE 0xFFFF
+
     /**
      * @brief
      *
@@ -65,40 +70,161 @@ namespace CppMqtt
     private:
         uint32_t count = 0;
         vector<Property *> properties;
+        // Position of the next property with the same identifier, for each property
+        vector<uint16_t> chain;
+        // Positions of the first and last property for each identifier
+        uint16_t first[PROPERTY_INDEX_SIZE];
+        uint16_t last[PROPERTY_INDEX_SIZE];
+        // Backing memory for properties decoded from a client
+        PropertyArena arena;
+        // Undecoded property block kept in lazy mode
+        vector<uint8_t> raw;
+        // Index slots that have been decoded from the raw block
+        uint64_t decoded = 0;
+        bool lazy = false;
+        bool pending = false;
+        // Set when a property could not be decoded, the packet is then malformed
+        bool malformed = false;
+        // Progress of a read from a client
         uint8_t state = 0;
+        VariableByteInteger propertiesLength;
+        VariableByteInteger propertyIdentifier;
+        Property *property = NULL;
+        uint32_t bytesRead = 0;
+
+        /**
+         * @brief Drops the progress of a partial read from a client
+         *
+         */
+        void resetRead();
+
+        static int slot(uint32_t identifier);
+        void clearIndex();
+        void addIndexed(Property *property);
+        /**
+         * @brief Decodes properties from the raw block for an index slot
+         *
+         * @param index The slot to decode, -1 decodes every remaining property
+         */
+        void decode(int index);
 
     protected:
     public:
+        /**
+         * @brief Iterates the properties that share an identifier, in the order they were added
+         */
+        class Iterator
+        {
+        private:
+            Properties *owner;
+            uint16_t position;
+
+        public:
+            Iterator(Properties *owner, uint16_t position) : owner(owner), position(position){};
+            Property *operator*() const { return owner->properties[position]; }
+            Iterator &operator++()
+            {
+                position = owner->chain[position];
+                return *this;
+            }
+            bool operator!=(const Iterator &right) const { return position != right.position; }
+            bool operator==(const Iterator &right) const { return position == right.position; }
+        };
+
+        class Range
+        {
+        private:
+            Properties *owner;
+            uint16_t position;
+
+        public:
+            Range(Properties *owner, uint16_t position) : owner(owner), position(position){};
+            Iterator begin() const { return Iterator(owner, position); }
+            Iterator end() const { return Iterator(owner, PROPERTY_INDEX_NONE); }
+        };
+
         Properties();
         Properties(uint32_t count);
+        // Properties own their Property pointers, so they can be moved but not copied
+        Properties(const Properties &) = delete;
+        Properties(Properties &&source);
+        Properties &operator=(const Properties &) = delete;
+        Properties &operator=(Properties &&right);
         virtual ~Properties();
         size_t size();
         size_t totalSize();
         uint32_t length();
         void addProperty(Property *property);
+        /**
+         * @brief Constructs a property in the arena and adds it
+         * The arena keeps its memory when cleared, so properties added to a reused packet do not allocate
+         *
+         * @param identifier The property to add
+         * @return Property* The added property, NULL if the arena has no memory left
+         */
+        Property *emplaceProperty(PropertyCodes identifier);
         void clear();
+        /**
+         * @brief Sets whether properties read from a client are decoded lazily
+         * In lazy mode only the raw property block is stored while reading. Properties are decoded
+         * the first time their identifier is accessed, others are skipped without being constructed.
+         *
+         * @param value
+         */
+        void setLazy(bool value);
+        bool isLazy();
+        /**
+         * @brief Returns whether a property could not be decoded, from an unknown identifier or no memory left
+         *
+         * @return true
+         * @return false
+         */
+        bool isMalformed() { return malformed; };
 
-        static Property *constructPropertyFromId(PropertyCodes identifier);
+        /**
+         * @brief Constructs an empty property from an identifier
+         *
+         * @param identifier
+         * @param arena Memory to construct the property in, if NULL the property is allocated with new
+         * @return Property* The property, NULL if the identifier is not known
+         */
+        static Property *constructPropertyFromId(PropertyCodes identifier, PropertyArena *arena = NULL);
+        /**
+         * @brief Returns the encoded size of a property value
+         *
+         * @param identifier The property identifier
+         * @param data The encoded value
+         * @param remaining The amount of bytes available
+         * @return int32_t The size of the value, -1 if the identifier is unknown or the value is truncated
+         */
+        static int32_t valueSize(uint32_t identifier, const uint8_t *data, size_t remaining);
 
         bool has(PropertyCodes identifier);
+        /**
+         * @brief Returns the first property with an identifier
+         *
+         * @param identifier
+         * @return Property* The property, NULL if there is none
+         */
         Property *get(PropertyCodes identifier);
+        /**
+         * @brief Returns every property with an identifier, used for repeatable properties
+         * such as USER_PROPERTY and SUBSCRIPTION_IDENTIFIER
+         *
+         * @param identifier
+         * @return Range
+         */
+        Range all(PropertyCodes identifier);
         template <typename T>
         void each(PropertyCodes identifier, std::function<bool(T *)> const &callback)
         {
-            // void Properties::each(PropertyCodes identifier, void (*callback)(T *))
-
-            auto result = properties.begin();
-            auto end = properties.end();
-
-            while (end != (result = ranges::find_if(result, end,
-                                                    [identifier](Property *property)
-                                                    { return property->getIdentifier() == identifier; })))
+            for (Property *property : all(identifier))
             {
-                if (!callback((T *)*result))
+                if (!callback((T *)property))
                 {
                     break;
                 }
-            };
+            }
         }
         void each(bool (*filter)(Property *), void (*callback)(Property *));
 
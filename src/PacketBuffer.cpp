@@ -13,7 +13,9 @@ PacketBuffer::PacketBuffer(size_t size) : length(size)
     }
     position = buffer;
 #else
-    buffer = position = (uint8_t *)malloc(size);
+    allocator = CppMqtt::getDefaultAllocator();
+    buffer = position = (uint8_t *)CppMqtt::allocateFrom(allocator, size);
+    capacity = size;
 #endif
 }
 
@@ -22,7 +24,7 @@ PacketBuffer::~PacketBuffer()
 #ifndef STATIC_MEMORY
     if (buffer != NULL)
     {
-        free(buffer);
+        allocator->deallocate(buffer, capacity);
     }
 #endif
 }
@@ -33,3 +35,26 @@ size_t PacketBuffer::push(const void *input, size_t size)
     position += size;
     return size;
 }
+
+void PacketBuffer::reset(size_t size)
+{
+#ifdef STATIC_MEMORY
+    if (size > MAX_PACKET_BUFFER_SIZE)
+    {
+        throw std::logic_error("Required Packet size greater than available.");
+    }
+#else
+    if (size > capacity)
+    {
+        if (buffer != NULL)
+        {
+            allocator->deallocate(buffer, capacity);
+        }
+
+        buffer = (uint8_t *)CppMqtt::allocateFrom(allocator, size);
+        capacity = size;
+    }
+#endif
+    position = buffer;
+    length = size;
+}
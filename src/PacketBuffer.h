@@ -3,6 +3,8 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include "Allocator.h"
+
 class PacketBuffer
 {
 private:
@@ -11,6 +13,8 @@ private:
     uint8_t buffer[MAX_PACKET_BUFFER_SIZE];
 #else
     uint8_t *buffer = NULL;
+    size_t capacity = 0;
+    CppMqtt::Allocator *allocator;
 #endif
     uint8_t *position;
     size_t length;
@@ -21,6 +25,12 @@ public:
     PacketBuffer(size_t size);
     ~PacketBuffer();
     size_t push(const void *input, size_t size);
+
+    /**
+     * @brief Rewinds the buffer to hold a new packet of the given size.
+     * Memory is only reallocated when the buffer needs to grow.
+     */
+    void reset(size_t size);
     size_t push(uint8_t value)
     {
         return push(&value, 1);
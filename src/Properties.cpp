@@ -31,9 +31,14 @@
 
 #include "MqttProperties.h"
 #include "stdlib.h"
+#include "BufferClient.h"
+#include <new>
+#include <string.h>
 
 #define PROPERTY_POINTER_SIZE sizeof(Property *)
 
+#define PROPERTY_CREATE(CLASS, ARENA) createProperty<CLASS>(ARENA)
+
 using namespace std;
 
 enum PropertiesReadState
@@ -41,13 +46,35 @@ enum PropertiesReadState
     LENGTH = 0,
     IDENTIFIER,
     PROPERTY_VALUE,
+    RAW_VALUE,
+    SKIP,
     COMPLETE
 };
 
 using namespace CppMqtt;
 
+/**
+ * @brief Constructs a property in an arena, or on the heap without one
+ * Placement new does not check for NULL, so an exhausted arena is caught before constructing
+ *
+ * @return Property* NULL if the arena has no memory left
+ */
+template <typename T>
+static Property *createProperty(PropertyArena *arena)
+{
+    if (arena == NULL)
+    {
+        return new T();
+    }
+
+    void *memory = arena->allocate(sizeof(T));
+
+    return (memory != NULL) ? new (memory) T() : NULL;
+}
+
 uint32_t Properties::length()
 {
+    decode(-1);
     return properties.size();
 }
 
@@ -62,6 +89,11 @@ size_t Properties::totalSize()
 
 size_t Properties::size()
 {
+    if (pending)
+    {
+        return raw.size();
+    }
+
     size_t size = 0;
 
     for (auto &property : properties)
@@ -80,6 +112,11 @@ size_t Properties::push(PacketBuffer &buffer)
 
     size_t written = propertiesLength.push(buffer);
 
+    if (pending)
+    {
+        return written + buffer.push(raw.data(), raw.size());
+    }
+
     for (auto &property : properties)
     {
         written += property->push(buffer);
@@ -88,18 +125,205 @@ size_t Properties::push(PacketBuffer &buffer)
     return written;
 }
 
+int Properties::slot(uint32_t identifier)
+{
+    if (identifier == SHARED_SUBSCRIPTION_AVAILABLE)
+    {
+        return 0;
+    }
+
+    return (identifier > 0 && identifier < PROPERTY_INDEX_SIZE) ? identifier : -1;
+}
+
+void Properties::clearIndex()
+{
+    chain.clear();
+    memset(first, 0xFF, sizeof(first));
+    memset(last, 0xFF, sizeof(last));
+}
+
+int32_t Properties::valueSize(uint32_t identifier, const uint8_t *data, size_t remaining)
+{
+    size_t length = 0;
+
+    switch (identifier)
+    {
+    case PAYLOAD_FORMAT_INDICATOR:
+    case REQUEST_PROBLEM_INFORMATION:
+    case REQUEST_RESPONSE_INFORMATION:
+    case MAXIMUM_QOS:
+    case RETAIN_AVAILABLE:
+    case WILDCARD_SUBSCRIPTION_AVAILABLE:
+    case SUBSCRIPTION_IDENTIFIERS_AVAILABLE:
+    case SHARED_SUBSCRIPTION_AVAILABLE:
+        length = 1;
+        break;
+    case SERVER_KEEP_ALIVE:
+    case RECEIVE_MAXIMUM:
+    case TOPIC_ALIAS_MAXIMUM:
+    case TOPIC_ALIAS:
+        length = 2;
+        break;
+    case MESSAGE_EXPIRY_INTERVAL:
+    case SESSION_EXPIRY_INTERVAL:
+    case WILL_DELAY_INTERVAL:
+    case MAXIMUM_PACKET_SIZE:
+        length = 4;
+        break;
+    case SUBSCRIPTION_IDENTIFIER:
+    {
+        uint32_t value;
+        length = VariableByteInteger::decode(data, remaining, value);
+    }
+    break;
+    case CONTENT_TYPE:
+    case RESPONSE_TOPIC:
+    case CORRELATION_DATA:
+    case ASSIGNED_CLIENT_IDENTIFER:
+    case AUTHENTICATION_METHOD:
+    case AUTHENTICATION_DATA:
+    case RESPONSE_INFORMATION:
+    case SERVER_REFERENCE:
+    case REASON_STRING:
+        if (remaining >= 2)
+        {
+            length = 2 + ((data[0] << 8) | data[1]);
+        }
+        break;
+    case USER_PROPERTY:
+        if (remaining >= 2)
+        {
+            length = 2 + ((data[0] << 8) | data[1]);
+        }
+        if (remaining >= length + 2)
+        {
+            length += 2 + ((data[length] << 8) | data[length + 1]);
+        }
+        break;
+    default:
+        return -1;
+    }
+
+    return (length > 0 && length <= remaining) ? length : -1;
+}
+
+void Properties::decode(int index)
+{
+    if (!pending || (index >= 0 && (decoded & (1ULL << index))))
+    {
+        return;
+    }
+
+    size_t position = 0;
+
+    while (position < raw.size())
+    {
+        uint32_t identifier = 0;
+        size_t consumed = VariableByteInteger::decode(raw.data() + position, raw.size() - position, identifier);
+
+        if (consumed == 0)
+        {
+            break;
+        }
+
+        position += consumed;
+
+        int32_t length = valueSize(identifier, raw.data() + position, raw.size() - position);
+
+        if (length < 0)
+        {
+            // Malformed or unknown, nothing after it can be located
+            break;
+        }
+
+        int entry = slot(identifier);
+
+        if ((index < 0 || entry == index) && !(decoded & (1ULL << entry)))
+        {
+            BufferClient valueReader(raw.data() + position, length);
+            Property *property = constructPropertyFromId(static_cast<PropertyCodes>(identifier), &arena);
+            uint32_t read = 0;
+
+            if (property == NULL)
+            {
+                malformed = true;
+                break;
+            }
+
+            property->readFromClient(&valueReader, read);
+            addIndexed(property);
+        }
+
+        position += length;
+    }
+
+    if (index < 0)
+    {
+        // Every property is materialized, the decoded list is now authoritative
+        pending = false;
+        decoded = 0;
+    }
+    else
+    {
+        decoded |= (1ULL << index);
+    }
+}
+
+void Properties::setLazy(bool value)
+{
+    lazy = value;
+}
+
+bool Properties::isLazy()
+{
+    return lazy;
+}
+
 void Properties::addProperty(Property *property)
 {
+    decode(-1);
+    addIndexed(property);
+}
+
+Property *Properties::emplaceProperty(PropertyCodes identifier)
+{
+    Property *property = constructPropertyFromId(identifier, &arena);
+
+    if (property != NULL)
+    {
+        addProperty(property);
+    }
+
+    return property;
+}
+
+void Properties::addIndexed(Property *property)
+{
+    uint16_t position = properties.size();
+    int index = slot(property->getIdentifier().value);
+
     properties.push_back(property);
+    chain.push_back(PROPERTY_INDEX_NONE);
+
+    if (index < 0 || position == PROPERTY_INDEX_NONE)
+    {
+        return;
+    }
+
+    if (first[index] == PROPERTY_INDEX_NONE)
+    {
+        first[index] = position;
+    }
+    else
+    {
+        chain[last[index]] = position;
+    }
+
+    last[index] = position;
 }
 
 bool Properties::readFromClient(Client *client, uint32_t &read)
 {
-    static VariableByteInteger propertiesLength;
-    static VariableByteInteger propertyIdentifier;
-    static Property *property;
-    static uint32_t bytesRead = 0;
-
     while (client->available() > 0 && (state == PropertiesReadState::LENGTH || bytesRead < propertiesLength.value))
     {
         switch (state)
@@ -109,31 +333,61 @@ bool Properties::readFromClient(Client *client, uint32_t &read)
             {
                 bytesRead = 0;
                 state = PropertiesReadState::IDENTIFIER;
-                // break;b
+                if (lazy)
+                {
+                    // Only the raw block is kept, properties are decoded when first accessed
+                    raw.resize(propertiesLength.value);
+                    pending = (propertiesLength.value > 0);
+                    state = PropertiesReadState::RAW_VALUE;
+                }
             }
             break;
+        case PropertiesReadState::RAW_VALUE:
+        {
+            uint32_t toRead = std::min(propertiesLength.value - bytesRead, (uint32_t)client->available());
+            bytesRead += client->read(raw.data() + bytesRead, toRead);
+        }
+        break;
         case PropertiesReadState::IDENTIFIER:
             while (client->available() > 0)
             {
                 if (!propertyIdentifier.readFromClient(client, bytesRead))
                 {
-
                     state = PropertiesReadState::PROPERTY_VALUE;
-                    property = constructPropertyFromId(static_cast<PropertyCodes>(propertyIdentifier.value));
+                    property = constructPropertyFromId(static_cast<PropertyCodes>(propertyIdentifier.value), &arena);
+
+                    if (property == NULL)
+                    {
+                        // Unknown identifier or no memory left, the rest of the block is discarded
+                        malformed = true;
+                        state = PropertiesReadState::SKIP;
+                    }
                     break;
                 }
             }
             break;
+        case PropertiesReadState::SKIP:
+        {
+            uint8_t discarded;
+            bytesRead += client->read(&discarded, 1);
+        }
+        break;
         case PropertiesReadState::PROPERTY_VALUE:
             if (!property->readFromClient(client, bytesRead))
             {
-                addProperty(property);
+                addIndexed(property);
+                property = NULL;
                 propertyIdentifier.value = 0;
                 if (bytesRead < propertiesLength.value)
                 {
                     state = PropertiesReadState::IDENTIFIER;
                 }
             }
+            else
+            {
+                // The value is only read once it has fully arrived
+                return true;
+            }
             break;
         default:
             break;
@@ -151,64 +405,64 @@ bool Properties::readFromClient(Client *client, uint32_t &read)
     return true;
 }
 
-Property *Properties::constructPropertyFromId(PropertyCodes identifier)
+Property *Properties::constructPropertyFromId(PropertyCodes identifier, PropertyArena *arena)
 {
     switch (identifier)
     {
     case PAYLOAD_FORMAT_INDICATOR:
-        return (Property *)new PayloadFormatIndicatorProperty();
+        return PROPERTY_CREATE(PayloadFormatIndicatorProperty, arena);
     case MESSAGE_EXPIRY_INTERVAL:
-        return (Property *)new MessageExpiryIntervalProperty();
+        return PROPERTY_CREATE(MessageExpiryIntervalProperty, arena);
     case CONTENT_TYPE:
-        return (Property *)new ContentTypeProperty();
+        return PROPERTY_CREATE(ContentTypeProperty, arena);
     case RESPONSE_TOPIC:
-        return (Property *)new ResponseTopic();
+        return PROPERTY_CREATE(ResponseTopic, arena);
     case CORRELATION_DATA:
-        return (Property *)new CorrelationData();
+        return PROPERTY_CREATE(CorrelationData, arena);
     case SUBSCRIPTION_IDENTIFIER:
-        return (Property *)new SubscriptionIdentifier();
+        return PROPERTY_CREATE(SubscriptionIdentifier, arena);
     case SESSION_EXPIRY_INTERVAL:
-        return (Property *)new SessionExpiryInterval();
+        return PROPERTY_CREATE(SessionExpiryInterval, arena);
     case ASSIGNED_CLIENT_IDENTIFER:
-        return (Property *)new AssignedClientIdentifier();
+        return PROPERTY_CREATE(AssignedClientIdentifier, arena);
     case SERVER_KEEP_ALIVE:
-        return (Property *)new ServerKeepAlive();
+        return PROPERTY_CREATE(ServerKeepAlive, arena);
     case AUTHENTICATION_METHOD:
-        return (Property *)new AuthenticationMethod();
+        return PROPERTY_CREATE(AuthenticationMethod, arena);
     case AUTHENTICATION_DATA:
-        return (Property *)new AuthenticationData();
+        return PROPERTY_CREATE(AuthenticationData, arena);
     case REQUEST_PROBLEM_INFORMATION:
-        return (Property *)new RequestProblemInformation();
+        return PROPERTY_CREATE(RequestProblemInformation, arena);
     case WILL_DELAY_INTERVAL:
-        return (Property *)new WillDelayInterval();
+        return PROPERTY_CREATE(WillDelayInterval, arena);
     case REQUEST_RESPONSE_INFORMATION:
-        return (Property *)new RequestResponseInformation();
+        return PROPERTY_CREATE(RequestResponseInformation, arena);
     case RESPONSE_INFORMATION:
-        return (Property *)new ResponseInformation();
+        return PROPERTY_CREATE(ResponseInformation, arena);
     case SERVER_REFERENCE:
-        return (Property *)new ServerReference();
+        return PROPERTY_CREATE(ServerReference, arena);
     case REASON_STRING:
-        return (Property *)new ReasonString();
+        return PROPERTY_CREATE(ReasonString, arena);
     case RECEIVE_MAXIMUM:
-        return (Property *)new ReceiveMaxium();
+        return PROPERTY_CREATE(ReceiveMaxium, arena);
     case TOPIC_ALIAS_MAXIMUM:
-        return (Property *)new TopicAliasMaximum();
+        return PROPERTY_CREATE(TopicAliasMaximum, arena);
     case TOPIC_ALIAS:
-        return (Property *)new TopicAlias();
+        return PROPERTY_CREATE(TopicAlias, arena);
     case MAXIMUM_QOS:
-        return (Property *)new MaxiumumQoS();
+        return PROPERTY_CREATE(MaxiumumQoS, arena);
     case RETAIN_AVAILABLE:
-        return (Property *)new RetainAvailable();
+        return PROPERTY_CREATE(RetainAvailable, arena);
     case USER_PROPERTY:
-        return (Property *)new UserProperty();
+        return PROPERTY_CREATE(UserProperty, arena);
     case MAXIMUM_PACKET_SIZE:
-        return (Property *)new MaximumPacketSize();
+        return PROPERTY_CREATE(MaximumPacketSize, arena);
     case WILDCARD_SUBSCRIPTION_AVAILABLE:
-        return (Property *)new WildcardSubscriptionAvailable();
+        return PROPERTY_CREATE(WildcardSubscriptionAvailable, arena);
     case SUBSCRIPTION_IDENTIFIERS_AVAILABLE:
-        return (Property *)new SubscriptionIdentifierAvailable();
+        return PROPERTY_CREATE(SubscriptionIdentifierAvailable, arena);
     case SHARED_SUBSCRIPTION_AVAILABLE:
-        return (Property *)new SharedSubscriptionAvailable();
+        return PROPERTY_CREATE(SharedSubscriptionAvailable, arena);
     default:
         break;
     }
@@ -217,20 +471,97 @@ Property *Properties::constructPropertyFromId(PropertyCodes identifier)
 
 Properties::Properties()
 {
+    clearIndex();
 }
 
 Properties::Properties(__attribute__((unused)) uint32_t count)
 {
+    clearIndex();
+}
+
+Properties::Properties(Properties &&source)
+    : properties(std::move(source.properties)), chain(std::move(source.chain)), arena(std::move(source.arena)),
+      raw(std::move(source.raw)), decoded(source.decoded), lazy(source.lazy), pending(source.pending),
+      malformed(source.malformed)
+{
+    source.raw.clear();
+    source.pending = false;
+    source.decoded = 0;
+    memcpy(first, source.first, sizeof(first));
+    memcpy(last, source.last, sizeof(last));
+    source.properties.clear();
+    source.clearIndex();
+}
+
+Properties &Properties::operator=(Properties &&right)
+{
+    if (&right != this)
+    {
+        clear();
+        properties = std::move(right.properties);
+        chain = std::move(right.chain);
+        memcpy(first, right.first, sizeof(first));
+        memcpy(last, right.last, sizeof(last));
+        arena = std::move(right.arena);
+        raw = std::move(right.raw);
+        decoded = right.decoded;
+        lazy = right.lazy;
+        pending = right.pending;
+        malformed = right.malformed;
+        right.raw.clear();
+        right.pending = false;
+        right.decoded = 0;
+        right.properties.clear();
+        right.clearIndex();
+    }
+    return *this;
+}
+
+void Properties::resetRead()
+{
+    // A property that is still being read has not been added yet
+    if (state == PropertiesReadState::PROPERTY_VALUE && property != NULL)
+    {
+        if (arena.owns(property))
+        {
+            property->~Property();
+        }
+        else
+        {
+            delete property;
+        }
+    }
+
+    state = PropertiesReadState::LENGTH;
+    propertiesLength.value = 0;
+    propertyIdentifier.value = 0;
+    property = NULL;
+    bytesRead = 0;
 }
 
 void Properties::clear()
 {
+    resetRead();
+
     for (auto &property : properties)
     {
-        delete property;
+        if (arena.owns(property))
+        {
+            property->~Property();
+        }
+        else
+        {
+            delete property;
+        }
     };
 
     properties.clear();
+    clearIndex();
+    arena.rewind();
+    raw.clear();
+    pending = false;
+    decoded = 0;
+    malformed = false;
 }
 
 Properties::~Properties()
@@ -245,6 +576,15 @@ bool Properties::has(PropertyCodes identifier)
 
 Property *Properties::get(PropertyCodes identifier)
 {
+    int index = slot(identifier);
+
+    decode(index);
+
+    if (index >= 0)
+    {
+        return (first[index] != PROPERTY_INDEX_NONE) ? properties[first[index]] : NULL;
+    }
+
     auto result = ranges::find_if(properties.begin(), properties.end(),
                                   [identifier](Property *property)
                                   { return property->getIdentifier() == identifier; });
@@ -252,6 +592,15 @@ Property *Properties::get(PropertyCodes identifier)
     return (result != properties.end()) ? *result : NULL;
 }
 
+Properties::Range Properties::all(PropertyCodes identifier)
+{
+    int index = slot(identifier);
+
+    decode(index);
+
+    return Range(this, (index >= 0) ? first[index] : PROPERTY_INDEX_NONE);
+}
+
 // // void Properties::each(PropertyCodes identifier, void (*callback)(T *))
 // template <typename T>
 // void Properties::each(PropertyCodes identifier, std::function<void(T *)> const &lambda)
@@ -269,6 +618,7 @@ Property *Properties::get(PropertyCodes identifier)
 // }
 void Properties::each(bool (*filter)(Property *), void (*callback)(Property *))
 {
+    decode(-1);
 
     auto result = properties.begin();
     auto end = properties.end();
@@ -0,0 +1,162 @@
+/*
+ * File: RecordingClient.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "RecordingClient.h"
+#include <string.h>
+#include "Clock.h"
+#include "types/VariableByteInteger.h"
+
+using namespace CppMqtt;
+
+RecordingClient::RecordingClient(Client *client, FILE *output) : client(client), output(output)
+{
+    uint8_t header[CAPTURE_MAGIC_LENGTH + 1];
+    memcpy(header, CAPTURE_MAGIC, CAPTURE_MAGIC_LENGTH);
+    header[CAPTURE_MAGIC_LENGTH] = CAPTURE_VERSION;
+
+    fwrite(header, 1, sizeof(header), output);
+    lastChunkTime = currentMicroseconds();
+}
+
+void RecordingClient::recordChunk(size_t unread, const uint8_t *data, size_t length)
+{
+    uint32_t now = currentMicroseconds();
+    uint32_t delay = now - lastChunkTime;
+    uint8_t header[12];
+    size_t headerLength = 0;
+
+    lastChunkTime = now;
+
+    headerLength += VariableByteInteger::encode(delay > VARIABLE_BYTE_INTEGER_MAX ? VARIABLE_BYTE_INTEGER_MAX : delay, header);
+    headerLength += VariableByteInteger::encode(unread, header + headerLength);
+    headerLength += VariableByteInteger::encode(length, header + headerLength);
+
+    fwrite(header, 1, headerLength, output);
+    fwrite(data, 1, length, output);
+    chunks++;
+}
+
+int RecordingClient::connect(const char *host, uint16_t port)
+{
+    return client->connect(host, port);
+}
+
+size_t RecordingClient::write(uint8_t byte)
+{
+    return client->write(byte);
+}
+
+size_t RecordingClient::write(const void *buffer, size_t size)
+{
+    return client->write(buffer, size);
+}
+
+int RecordingClient::available()
+{
+    int incoming = client->available();
+
+    if (incoming > VARIABLE_BYTE_INTEGER_MAX)
+    {
+        incoming = VARIABLE_BYTE_INTEGER_MAX;
+    }
+
+    if (incoming > 0)
+    {
+        if (position == pending.size())
+        {
+            pending.clear();
+            position = 0;
+        }
+
+        size_t unread = pending.size() - position;
+        size_t start = pending.size();
+
+        pending.resize(start + incoming);
+        int received = client->read(pending.data() + start, incoming);
+        pending.resize(start + (received > 0 ? received : 0));
+
+        if (received > 0)
+        {
+            recordChunk(unread, pending.data() + start, received);
+        }
+    }
+
+    return pending.size() - position;
+}
+
+int RecordingClient::read(void *buffer, size_t size)
+{
+    if (pending.size() - position < size)
+    {
+        available();
+    }
+
+    size_t remaining = pending.size() - position;
+
+    if (size > remaining)
+    {
+        size = remaining;
+    }
+
+    if (size > 0)
+    {
+        memcpy(buffer, pending.data() + position, size);
+        position += size;
+    }
+
+    return size;
+}
+
+void RecordingClient::stop()
+{
+    client->stop();
+}
+
+uint8_t RecordingClient::connected()
+{
+    return client->connected();
+}
+
+void RecordingClient::sync()
+{
+    client->sync();
+}
+
+int RecordingClient::getFileDescriptor()
+{
+    return client->getFileDescriptor();
+}
+
+bool RecordingClient::writePending()
+{
+    return client->writePending();
+}
@@ -0,0 +1,98 @@
+/*
+ * File: RecordingClient.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef RECORDINGCLIENT
+#define RECORDINGCLIENT
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "Client.h"
+
+#define CAPTURE_MAGIC "MQRC"
+#define CAPTURE_MAGIC_LENGTH 4
+#define CAPTURE_VERSION 1
+
+/**
+ * @brief A client decorator that records the inbound byte stream of another client
+ * Bytes are pulled from the wrapped client whenever it has more available, and each pull is written to the
+ * capture as a chunk, so a ReplayClient can present the stream with the same fragmentation.
+ *
+ * A capture is the magic "MQRC" and a version byte, followed by a chunk for each pull:
+ * - Microseconds since the previous chunk, as a Variable Byte Integer
+ * - Bytes received earlier that were still unread, as a Variable Byte Integer
+ * - The length of the chunk, as a Variable Byte Integer
+ * - The bytes of the chunk
+ * Gaps longer than the largest Variable Byte Integer, about 268 seconds, are shortened to it.
+ */
+class RecordingClient : public Client
+{
+private:
+    Client *client;
+    FILE *output;
+    std::vector<uint8_t> pending;
+    size_t position = 0;
+    uint32_t lastChunkTime;
+    uint32_t chunks = 0;
+
+    void recordChunk(size_t unread, const uint8_t *data, size_t length);
+
+protected:
+public:
+    /**
+     * @brief Records the bytes received by a client
+     *
+     * @param client The client to wrap, which every call is forwarded to
+     * @param output An open binary file the capture is written to, the caller flushes and closes it
+     */
+    RecordingClient(Client *client, FILE *output);
+
+    int connect(const char *host, uint16_t port) override;
+    size_t write(uint8_t) override;
+    size_t write(const void *buffer, size_t size) override;
+    int available() override;
+    int read(void *buffer, size_t size) override;
+    void stop() override;
+    uint8_t connected() override;
+    void sync() override;
+    int getFileDescriptor() override;
+    bool writePending() override;
+
+    /**
+     * @brief The amount of chunks recorded
+     *
+     * @return uint32_t
+     */
+    uint32_t getChunks() { return chunks; };
+};
+
+#endif /* RECORDINGCLIENT */
@@ -0,0 +1,196 @@
+/*
+ * File: ReplayClient.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "ReplayClient.h"
+#include <string.h>
+#include "Clock.h"
+#include "types/VariableByteInteger.h"
+
+using namespace CppMqtt;
+
+int ReplayClient::load(const void *data, size_t length)
+{
+    const uint8_t *input = (const uint8_t *)data;
+
+    if (length < CAPTURE_MAGIC_LENGTH + 1 || memcmp(input, CAPTURE_MAGIC, CAPTURE_MAGIC_LENGTH) != 0 ||
+        input[CAPTURE_MAGIC_LENGTH] != CAPTURE_VERSION)
+    {
+        return -1;
+    }
+
+    capture.assign(input, input + length);
+
+    // Walks the chunks to validate them and to size the pending buffer
+    size_t offset = CAPTURE_MAGIC_LENGTH + 1;
+    size_t largest = 0;
+
+    recordedBytes = 0;
+
+    while (offset < capture.size())
+    {
+        uint32_t delay, unread, chunkLength;
+        size_t used;
+
+        if ((used = VariableByteInteger::decode(capture.data() + offset, capture.size() - offset, delay)) == 0)
+            return -1;
+        offset += used;
+
+        if ((used = VariableByteInteger::decode(capture.data() + offset, capture.size() - offset, unread)) == 0)
+            return -1;
+        offset += used;
+
+        if ((used = VariableByteInteger::decode(capture.data() + offset, capture.size() - offset, chunkLength)) == 0)
+            return -1;
+        offset += used;
+
+        if (chunkLength > capture.size() - offset)
+        {
+            return -1;
+        }
+
+        offset += chunkLength;
+        recordedBytes += chunkLength;
+        largest = (unread + chunkLength > largest) ? unread + chunkLength : largest;
+    }
+
+    pending.reserve(largest);
+    rewind();
+
+    return 0;
+}
+
+int ReplayClient::load(FILE *input)
+{
+    std::vector<uint8_t> data;
+    uint8_t block[4096];
+    size_t read;
+
+    while ((read = fread(block, 1, sizeof(block), input)) > 0)
+    {
+        data.insert(data.end(), block, block + read);
+    }
+
+    return load(data.data(), data.size());
+}
+
+void ReplayClient::rewind()
+{
+    nextChunk = CAPTURE_MAGIC_LENGTH + 1;
+    pending.clear();
+    position = 0;
+    elapsed = 0;
+    chunkTime = 0;
+    started = false;
+}
+
+bool ReplayClient::finished()
+{
+    return nextChunk >= capture.size() && position == pending.size();
+}
+
+bool ReplayClient::revealChunk()
+{
+    if (nextChunk >= capture.size())
+    {
+        return false;
+    }
+
+    const uint8_t *input = capture.data() + nextChunk;
+    size_t remaining = capture.size() - nextChunk;
+    uint32_t delay, unread, length;
+    size_t used = VariableByteInteger::decode(input, remaining, delay);
+    used += VariableByteInteger::decode(input + used, remaining - used, unread);
+    used += VariableByteInteger::decode(input + used, remaining - used, length);
+
+    // The chunk arrived when this many bytes were still unread, so it is held back until the reader catches up
+    if (pending.size() - position > unread)
+    {
+        return false;
+    }
+
+    if (realTime)
+    {
+        uint32_t now = currentMicroseconds();
+
+        if (!started)
+        {
+            started = true;
+        }
+        else
+        {
+            elapsed += now - lastTime;
+        }
+
+        lastTime = now;
+
+        if (elapsed < chunkTime + delay)
+        {
+            return false;
+        }
+    }
+
+    chunkTime += delay;
+
+    // Drops the bytes already read so the reserved capacity is never exceeded
+    pending.erase(pending.begin(), pending.begin() + position);
+    position = 0;
+
+    pending.insert(pending.end(), input + used, input + used + length);
+    nextChunk += used + length;
+
+    return true;
+}
+
+int ReplayClient::available()
+{
+    revealChunk();
+
+    return pending.size() - position;
+}
+
+int ReplayClient::read(void *buffer, size_t size)
+{
+    size_t remaining = pending.size() - position;
+
+    if (size > remaining)
+    {
+        size = remaining;
+    }
+
+    if (size > 0)
+    {
+        memcpy(buffer, pending.data() + position, size);
+        position += size;
+    }
+
+    return size;
+}
@@ -0,0 +1,117 @@
+/*
+ * File: ReplayClient.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef REPLAYCLIENT
+#define REPLAYCLIENT
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "Client.h"
+#include "RecordingClient.h"
+
+/**
+ * @brief A client that plays back a capture written by a RecordingClient
+ * Bytes become available in the chunks they were recorded in, so packets are read with the same fragmentation.
+ * Each call to available reveals at most one chunk, once the unread bytes have dropped to what was unread when the
+ * chunk was recorded. In real time mode chunks are also held back until their recorded delay has passed.
+ * Writes are discarded.
+ */
+class ReplayClient : public Client
+{
+private:
+    std::vector<uint8_t> capture;
+    // Offset of the next chunk header in the capture
+    size_t nextChunk = 0;
+    // Revealed bytes, reserved on load to the largest chunk so playback does not allocate
+    std::vector<uint8_t> pending;
+    size_t position = 0;
+    size_t recordedBytes = 0;
+    bool realTime;
+    uint64_t elapsed = 0;
+    uint64_t chunkTime = 0;
+    uint32_t lastTime = 0;
+    bool started = false;
+
+    bool revealChunk();
+
+protected:
+public:
+    ReplayClient(bool realTime = false) : realTime(realTime){};
+
+    /**
+     * @brief Loads a capture from memory
+     *
+     * @param data The capture, copied into the client
+     * @param length
+     * @return int 0 on success, -1 if the data is not a capture
+     */
+    int load(const void *data, size_t length);
+    /**
+     * @brief Loads a capture from a file, reading it fully so playback does no file access
+     *
+     * @param input An open binary file
+     * @return int 0 on success, -1 if the file is not a capture
+     */
+    int load(FILE *input);
+
+    /**
+     * @brief The amount of bytes recorded in the loaded capture
+     *
+     * @return size_t
+     */
+    size_t getRecordedBytes() { return recordedBytes; };
+
+    /**
+     * @brief Starts the playback again from the first chunk
+     */
+    void rewind();
+
+    /**
+     * @brief Returns whether every recorded byte has been read
+     *
+     * @return true
+     * @return false
+     */
+    bool finished();
+
+    int connect(const char *, uint16_t) override { return 1; };
+    size_t write(uint8_t) override { return 1; };
+    size_t write(const void *, size_t size) override { return size; };
+    int available() override;
+    int read(void *buffer, size_t size) override;
+    void stop() override{};
+    uint8_t connected() override { return 1; };
+    void sync() override{};
+};
+
+#endif /* REPLAYCLIENT */
@@ -118,9 +118,14 @@ bool Acknowledge::readFromClient(Client *client, uint32_t &bytes)
         }
 
         readBytes(read);
+
+        if (read == 0)
+        {
+            break;
+        }
     }
 
-    bytes += getRemainingLength() - start;
+    bytes += start - getRemainingLength();
 
     if (!dataRemaining())
     {
@@ -148,4 +153,12 @@ void Acknowledge::setReasonCode(uint16_t value)
 void Acknowledge::setPacketIdentifier(uint16_t value)
 {
     packetIdentifier = value;
-}
\ No newline at end of file
+}
+
+void Acknowledge::reset(uint8_t fixedHeaderByte)
+{
+    PropertiesPacket::reset(fixedHeaderByte);
+    state = IDLE;
+    packetIdentifier = 0;
+    reasonCode = 0;
+}
@@ -47,7 +47,7 @@ namespace CppMqtt
     private:
         uint8_t state = 0;
         uint16_t packetIdentifier;
-        uint8_t reasonCode;
+        uint8_t reasonCode = 0;
 
     protected:
         Acknowledge(uint8_t fixedHeaderByte) : PropertiesPacket(fixedHeaderByte){};
@@ -79,6 +79,12 @@ namespace CppMqtt
         void setReasonCode(uint16_t value);
         uint16_t getPacketIdentifier();
         void setPacketIdentifier(uint16_t value);
+        /**
+         * @brief Returns the packet to a freshly constructed state so it can be reused
+         *
+         * @param fixedHeaderByte
+         */
+        virtual void reset(uint8_t fixedHeaderByte) override;
     };
 
 }
@@ -97,7 +97,7 @@ bool Authentication::readFromClient(Client *client, uint32_t &bytes)
         readBytes(read);
     }
 
-    bytes += getRemainingLength() - start;
+    bytes += start - getRemainingLength();
     return state == COMPLETE;
 }
 
@@ -110,3 +110,10 @@ bool Authentication::validate()
 {
     return true;
 }
+
+void Authentication::reset(uint8_t fixedHeaderByte)
+{
+    PropertiesPacket::reset(fixedHeaderByte);
+    state = IDLE;
+    reasonCode = 0;
+}
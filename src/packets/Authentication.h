@@ -74,6 +74,12 @@ namespace CppMqtt
          * @return size_t
          */
         size_t size();
+        /**
+         * @brief Returns the packet to a freshly constructed state so it can be reused
+         *
+         * @param fixedHeaderByte
+         */
+        virtual void reset(uint8_t fixedHeaderByte) override;
         /**
          * @brief Validates the packet to the MQTT 5 standards
          *
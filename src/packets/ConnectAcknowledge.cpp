@@ -43,8 +43,9 @@ enum ReadingState
 
 #define VARIABLE_HEADER_FIXED_SIZE 2
 
-ConnectAcknowledge::ConnectAcknowledge() : PropertiesPacket(0)
+ConnectAcknowledge::ConnectAcknowledge() : PropertiesPacket(PacketId::CONNECT_ACKNOWLEDGE)
 {
+    header.data = 0;
 }
 
 ConnectAcknowledge::ConnectAcknowledge(uint8_t flags) : PropertiesPacket(PacketId::CONNECT_ACKNOWLEDGE | (flags & HEADER_BYTES_MASK))
@@ -84,18 +85,54 @@ bool ConnectAcknowledge::readFromClient(Client *client, uint32_t &read)
         }
 
         readBytes(bytes);
+
+        if (bytes == 0)
+        {
+            break;
+        }
     }
 
-    read += getRemainingLength() - start;
+    read += start - getRemainingLength();
 
     return state != COMPLETE;
 }
 
+size_t ConnectAcknowledge::size()
+{
+    return VARIABLE_HEADER_FIXED_SIZE + properties.totalSize();
+}
+
+size_t ConnectAcknowledge::push(PacketBuffer &buffer)
+{
+    // Fixed Header
+    size_t written = Packet::push(buffer);
+
+    written += buffer.push(&(header.data), VARIABLE_HEADER_FIXED_SIZE);
+    written += properties.push(buffer);
+
+    return written;
+}
+
 uint8_t ConnectAcknowledge::getReasonCode()
 {
     return header.reasonCode;
 }
 
+void ConnectAcknowledge::setReasonCode(uint8_t value)
+{
+    header.reasonCode = value;
+}
+
+bool ConnectAcknowledge::getSessionPresent()
+{
+    return header.session;
+}
+
+void ConnectAcknowledge::setSessionPresent(bool value)
+{
+    header.session = value;
+}
+
 uint32_t ConnectAcknowledge::getSessionExpiryInterval()
 {
     Property *property = properties.get(SESSION_EXPIRY_INTERVAL);
@@ -286,6 +323,13 @@ bool ConnectAcknowledge::validate()
 {
 
     return getFixedHeaderFlags() == 0 && // All Fixed flags should be zero
-           ((header.data >> 9) == 0);    // Bits 1-7 of the variable header are reserved and must be 0
+           header.reserved == 0;         // Bits 1-7 of the acknowledge flags are reserved and must be 0
     // TODO: Reason Code Validation
 }
+
+void ConnectAcknowledge::reset(uint8_t fixedHeaderByte)
+{
+    PropertiesPacket::reset(fixedHeaderByte);
+    state = IDLE;
+    header.data = 0;
+}
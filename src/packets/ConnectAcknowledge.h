@@ -44,8 +44,8 @@ namespace CppMqtt
     {
         struct
         {
-            uint8_t reserved : 7;
             uint8_t session : 1;
+            uint8_t reserved : 7;
             uint8_t reasonCode;
         };
         uint16_t data;
@@ -65,14 +65,14 @@ namespace CppMqtt
     public:
         ConnectAcknowledge();
         ConnectAcknowledge(uint8_t flags);
-        size_t size() { return 0; };
+        size_t size();
         /**
          * @brief Pushes the contents of the Connect Acknowledge to a communications client
          *
          * @param client The client to push data to
          * @return size_t The amount of bytes written
          */
-        virtual size_t push(__attribute__((unused)) PacketBuffer &buffer) override { return 0; };
+        virtual size_t push(PacketBuffer &buffer) override;
         /**
          * @brief Reads data from a client which will then be used to fill in the Connect Acknowledge Packet
          *
@@ -99,6 +99,15 @@ namespace CppMqtt
         EncodedString getAuthenticationMethod();
         BinaryData getAuthenticationData();
         uint8_t getReasonCode();
+        void setReasonCode(uint8_t value);
+        bool getSessionPresent();
+        void setSessionPresent(bool value);
+        /**
+         * @brief Returns the packet to a freshly constructed state so it can be reused
+         *
+         * @param fixedHeaderByte
+         */
+        virtual void reset(uint8_t fixedHeaderByte) override;
         /**
          * @brief Validates the packet to the MQTT 5 standards
          *
@@ -98,7 +98,7 @@ bool Disconnect::readFromClient(Client *client, uint32_t &bytes)
         readBytes(read);
     }
 
-    bytes += getRemainingLength() - start;
+    bytes += start - getRemainingLength();
     return state == COMPLETE;
 }
 
@@ -121,3 +121,10 @@ bool Disconnect::validate()
 {
     return true;
 }
+
+void Disconnect::reset(uint8_t fixedHeaderByte)
+{
+    PropertiesPacket::reset(fixedHeaderByte);
+    state = IDLE;
+    reasonCode = 0;
+}
@@ -84,6 +84,12 @@ namespace CppMqtt
          * @param value
          */
         uint8_t getReasonCode();
+        /**
+         * @brief Returns the packet to a freshly constructed state so it can be reused
+         *
+         * @param fixedHeaderByte
+         */
+        virtual void reset(uint8_t fixedHeaderByte) override;
         /**
          * @brief Validates the packet to the MQTT 5 standards
          *
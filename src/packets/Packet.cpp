@@ -100,6 +100,14 @@ void Packet::setRemainingLength(uint32_t remainingLength)
     this->remainingLength = remainingLength;
 }
 
+void Packet::reset(uint8_t fixedHeaderByte)
+{
+    fixedHeader.data = fixedHeaderByte;
+    state = 0;
+    remainingLength = 0;
+    bytesRead = 0;
+}
+
 uint8_t Packet::getPacketType()
 {
     return (fixedHeader.data & 0xF0);
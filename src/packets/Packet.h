@@ -37,6 +37,7 @@
 #include "types/EncodedString.h"
 #include "Client.h"
 #include "ClientInteractor.h"
+#include "Allocator.h"
 #include "utils/enum.h"
 
 #define HEADER_BYTES_MASK 0xF
@@ -147,6 +148,13 @@ namespace CppMqtt
         Packet(uint8_t fixedHeaderByte);
         Packet(FixedHeader fixedHeader);
         virtual ~Packet();
+
+        // Heap packets are reserved through the default Allocator
+        static void *operator new(size_t size) { return allocateObject(size); }
+        static void *operator new(size_t, void *pointer) { return pointer; }
+        static void operator delete(void *pointer) { deallocateObject(pointer); }
+        static void operator delete(void *, void *) {}
+
         virtual size_t size() = 0;
         virtual bool readFromClient(Client *client, uint32_t &read) = 0;
         virtual size_t push(PacketBuffer &buffer) = 0;
@@ -155,6 +163,13 @@ namespace CppMqtt
         void setRemainingLength(VariableByteInteger remainingLength);
         void setRemainingLength(uint32_t remainingLength);
         uint8_t getPacketType();
+        /**
+         * @brief Returns the packet to a freshly constructed state so it can be reused
+         * Avoids destroying and reallocating packets on the receive path
+         *
+         * @param fixedHeaderByte
+         */
+        virtual void reset(uint8_t fixedHeaderByte);
         /**
          * @brief Validates the packet to the MQTT 5 standards
          *
@@ -162,6 +177,13 @@ namespace CppMqtt
          * @return false
          */
         virtual bool validate() = 0;
+        /**
+         * @brief Returns whether the packet read from a client could not be decoded
+         *
+         * @return true
+         * @return false
+         */
+        virtual bool malformed() { return false; };
     };
 }
 
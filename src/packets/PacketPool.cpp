@@ -0,0 +1,105 @@
+/*
+ * File: PacketPool.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "packets/PacketPool.h"
+
+using namespace CppMqtt;
+
+Packet *PacketPool::get(uint8_t identifier)
+{
+    switch (identifier & 0xF0) // Strip lower 4 bits
+    {
+    case PacketId::CONNECT:
+        return &connect;
+    case PacketId::CONNECT_ACKNOWLEDGE:
+        return &connectAcknowledge;
+    case PacketId::PUBLISH:
+        return &publish;
+    case PacketId::PUBLISH_ACKNOWLEDGE:
+        return &publishAcknowledge;
+    case PacketId::PUBLISH_RECEIVED:
+        return &publishReceived;
+    case PacketId::PUBLISH_RELEASE:
+        return &publishRelease;
+    case PacketId::PUBLISH_COMPLETE:
+        return &publishComplete;
+    case PacketId::SUBSCRIBE:
+        return &subscribe;
+    case PacketId::SUBSCRIBE_ACKNOWLEDGE:
+        return &subscribeAcknowledge;
+    case PacketId::UNSUBSCRIBE:
+        return &unsubscribe;
+    case PacketId::UNSUBSCRIBE_ACKNOWLEDGE:
+        return &unsubscribeAcknowledge;
+    case PacketId::PING_REQUEST:
+        return &pingRequest;
+    case PacketId::PING_RESPONSE:
+        return &pingResponse;
+    case PacketId::DISCONNECT:
+        return &disconnect;
+    case PacketId::AUTHENTICATION:
+        return &authentication;
+    default:
+        break;
+    }
+    return NULL;
+}
+
+Packet *PacketPool::acquire(uint8_t identifier)
+{
+    Packet *packet = get(identifier);
+
+    if (packet != NULL)
+    {
+        packet->reset(identifier);
+    }
+
+    return packet;
+}
+
+void PacketPool::release(Packet *packet)
+{
+    if (packet != NULL)
+    {
+        // Drops properties and state, owned payload buffers are kept for reuse
+        packet->reset(0);
+    }
+}
+
+void PacketPool::resetProgress()
+{
+    release(progress.packet);
+    progress.state = 0;
+    progress.controlPacket = 0;
+    progress.length = 0;
+    progress.packet = NULL;
+}
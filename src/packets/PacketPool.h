@@ -0,0 +1,126 @@
+/*
+ * File: PacketPool.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef SRC_PACKETS_PACKETPOOL
+#define SRC_PACKETS_PACKETPOOL
+
+#include "Packet.h"
+#include "Authentication.h"
+#include "Connect.h"
+#include "ConnectAcknowledge.h"
+#include "Disconnect.h"
+#include "PingRequest.h"
+#include "PingResponse.h"
+#include "Publish.h"
+#include "PublishAcknowledge.h"
+#include "PublishComplete.h"
+#include "PublishReceived.h"
+#include "PublishRelease.h"
+#include "Subscribe.h"
+#include "SubscribeAcknowledge.h"
+#include "Unsubscribe.h"
+#include "UnsubscribeAcknowledge.h"
+#include "types/VariableByteInteger.h"
+
+namespace CppMqtt
+{
+    /**
+     * @brief Progress of the packet currently being read from a connection
+     */
+    struct PacketReadProgress
+    {
+        uint8_t state = 0;
+        uint8_t controlPacket = 0;
+        VariableByteInteger length = 0;
+        Packet *packet = NULL;
+    };
+
+    /**
+     * @brief A per connection pool of packets for the receive path
+     * Holds a recycled instance of every packet type. Packets are reset rather than destroyed,
+     * so reading packets causes no allocator traffic in either memory mode.
+     * The receive path only ever holds a single inbound packet, so one instance of each type is enough.
+     */
+    class PacketPool
+    {
+    private:
+        Authentication authentication;
+        Connect connect;
+        ConnectAcknowledge connectAcknowledge;
+        Disconnect disconnect;
+        PingRequest pingRequest;
+        PingResponse pingResponse;
+        Publish publish;
+        PublishAcknowledge publishAcknowledge;
+        PublishComplete publishComplete;
+        PublishReceived publishReceived;
+        PublishRelease publishRelease;
+        Subscribe subscribe;
+        SubscribeAcknowledge subscribeAcknowledge;
+        Unsubscribe unsubscribe;
+        UnsubscribeAcknowledge unsubscribeAcknowledge;
+        PacketReadProgress progress;
+
+        Packet *get(uint8_t identifier);
+
+    protected:
+    public:
+        /**
+         * @brief Returns a reset packet for a fixed header
+         *
+         * @param identifier The fixed header byte of the packet
+         * @return Packet* The packet, NULL if the identifier is not a known packet type
+         */
+        Packet *acquire(uint8_t identifier);
+        /**
+         * @brief Returns a packet to the pool once it has been processed
+         *
+         * @param packet
+         */
+        void release(Packet *packet);
+        /**
+         * @brief Returns the read progress of the connection the pool belongs to
+         * Kept with the pool so connections can be read independently of one another
+         *
+         * @return PacketReadProgress&
+         */
+        PacketReadProgress &getReadProgress() { return progress; };
+        /**
+         * @brief Drops the read progress and any partially read packet
+         * Used when the connection is lost, so the next connection starts on a packet boundary
+         *
+         */
+        void resetProgress();
+    };
+}
+
+#endif /* SRC_PACKETS_PACKETPOOL */
@@ -0,0 +1,115 @@
+/*
+ * File: PacketTemplates.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+/**
+ * @brief Pre-encoded byte layouts for control packets with a fixed shape
+ * PINGREQ, PINGRESP, acknowledgements with a success reason and no properties, and DISCONNECT
+ * without properties never change shape, so they are built at compile time and sent with
+ * a small copy instead of being encoded through a Packet.
+ */
+
+#ifndef SRC_PACKETS_PACKETTEMPLATES
+#define SRC_PACKETS_PACKETTEMPLATES
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "Packet.h"
+
+namespace CppMqtt
+{
+    template <size_t N>
+    struct PacketTemplate
+    {
+        uint8_t bytes[N];
+
+        static constexpr size_t size() { return N; }
+    };
+
+    /**
+     * @brief A fixed header with no remaining data
+     *
+     * @param fixedHeader
+     * @return constexpr PacketTemplate<2>
+     */
+    constexpr PacketTemplate<2> emptyPacketTemplate(uint8_t fixedHeader)
+    {
+        return {{fixedHeader, 0}};
+    }
+
+    /**
+     * @brief An acknowledgement holding only a packet identifier, which implies a success reason code
+     *
+     * @param fixedHeader
+     * @return constexpr PacketTemplate<4>
+     */
+    constexpr PacketTemplate<4> acknowledgeTemplate(uint8_t fixedHeader)
+    {
+        return {{fixedHeader, 2, 0, 0}};
+    }
+
+    /**
+     * @brief A disconnect holding a reason code and an empty property length
+     *
+     * @param reasonCode
+     * @return constexpr PacketTemplate<4>
+     */
+    constexpr PacketTemplate<4> disconnectTemplate(uint8_t reasonCode)
+    {
+        return {{(uint8_t)PacketId::DISCONNECT, 2, reasonCode, 0}};
+    }
+
+    inline constexpr PacketTemplate<2> PING_REQUEST_TEMPLATE = emptyPacketTemplate(PacketId::PING_REQUEST);
+    inline constexpr PacketTemplate<2> PING_RESPONSE_TEMPLATE = emptyPacketTemplate(PacketId::PING_RESPONSE);
+    inline constexpr PacketTemplate<4> PUBLISH_ACKNOWLEDGE_TEMPLATE = acknowledgeTemplate(PacketId::PUBLISH_ACKNOWLEDGE);
+    inline constexpr PacketTemplate<4> PUBLISH_RECEIVED_TEMPLATE = acknowledgeTemplate(PacketId::PUBLISH_RECEIVED);
+    // Publish release must set the 2nd bit in the Fixed Header
+    inline constexpr PacketTemplate<4> PUBLISH_RELEASE_TEMPLATE = acknowledgeTemplate(PacketId::PUBLISH_RELEASE | 2);
+    inline constexpr PacketTemplate<4> PUBLISH_COMPLETE_TEMPLATE = acknowledgeTemplate(PacketId::PUBLISH_COMPLETE);
+    inline constexpr PacketTemplate<4> DISCONNECT_TEMPLATE = disconnectTemplate(ReasonCode::NORMAL_DISCONNECTION);
+
+    /**
+     * @brief Copies an acknowledgement template with a packet identifier filled in
+     * The identifier is written in the same byte order used by Acknowledge::push
+     *
+     * @param packet The template
+     * @param identifier The packet identifier
+     * @return PacketTemplate<4>
+     */
+    inline PacketTemplate<4> withPacketIdentifier(PacketTemplate<4> packet, uint16_t identifier)
+    {
+        memcpy(&packet.bytes[2], &identifier, sizeof(identifier));
+        return packet;
+    }
+}
+
+#endif /* SRC_PACKETS_PACKETTEMPLATES */
@@ -88,59 +88,55 @@ namespace CppMqtt
         return NULL;
     }
 
-    Packet *readPacketFromClient(Client *client)
+    static Packet *readPacket(Client *client, PacketPool *pool, PacketReadProgress &progress, uint32_t &read)
     {
-        uint32_t read = 0;
-        static ReadState state = ReadState::IDENTIFIER_FLAGS;
-        static uint8_t controlPacket;
-        static VariableByteInteger length = 0;
-        static Packet *packet;
-
         while (client->available() > 0)
         {
-            switch (state)
+            switch ((ReadState)progress.state)
             {
             case ReadState::IDENTIFIER_FLAGS:
-                client->read(&controlPacket, 1);
-                state = ReadState::PACKET_LENGTH;
-                packet = constructPacketFromId(controlPacket);
-                packet->setFlags(controlPacket);
+                read += client->read(&progress.controlPacket, 1);
+                progress.state = (uint8_t)ReadState::PACKET_LENGTH;
+                progress.packet = (pool != NULL) ? pool->acquire(progress.controlPacket) : constructPacketFromId(progress.controlPacket);
+                progress.packet->setFlags(progress.controlPacket);
                 // TODO: Malformed packet check
                 break;
             case ReadState::PACKET_LENGTH:
-                if (!length.readFromClient(client, read))
+                if (!progress.length.readFromClient(client, read))
                 {
                     // TODO: Max Packet length check
-                    if (length == 0)
+                    if (progress.length == 0)
                     {
-                        state = ReadState::IDENTIFIER_FLAGS;
-                        length = 0;
-                        controlPacket = 0;
+                        progress.state = (uint8_t)ReadState::IDENTIFIER_FLAGS;
+                        progress.length = 0;
+                        progress.controlPacket = 0;
                         {
-                            Packet *result = packet;
-                            packet = NULL;
+                            Packet *result = progress.packet;
+                            progress.packet = NULL;
                             return result;
                         }
                     }
 
-                    state = ReadState::PACKET_CONTENTS;
+                    progress.state = (uint8_t)ReadState::PACKET_CONTENTS;
 
-                    packet->setRemainingLength(length);
+                    progress.packet->setRemainingLength(progress.length);
                 }
                 break;
             case ReadState::PACKET_CONTENTS:
-                if (!packet->readFromClient(client, read))
+                if (!progress.packet->readFromClient(client, read))
                 {
-                    state = ReadState::IDENTIFIER_FLAGS;
-                    length = 0;
-                    controlPacket = 0;
+                    progress.state = (uint8_t)ReadState::IDENTIFIER_FLAGS;
+                    progress.length = 0;
+                    progress.controlPacket = 0;
                     {
-                        Packet *result = packet;
-                        packet = NULL;
+                        Packet *result = progress.packet;
+                        progress.packet = NULL;
                         return result;
                     }
                 }
-                break;
+                // The packet reads everything it can, the rest is waiting on more data. Packet readers only take a
+                // field once all of it has arrived, and leave their loop when a pass reads nothing rather than spin
+                return NULL;
 
             default:
                 break;
@@ -149,4 +145,22 @@ namespace CppMqtt
 
         return NULL;
     }
+
+    Packet *readPacketFromClient(Client *client)
+    {
+        static PacketReadProgress progress;
+        uint32_t read = 0;
+        return readPacket(client, NULL, progress, read);
+    }
+
+    Packet *readPacketFromClient(Client *client, PacketPool &pool)
+    {
+        uint32_t read = 0;
+        return readPacket(client, &pool, pool.getReadProgress(), read);
+    }
+
+    Packet *readPacketFromClient(Client *client, PacketPool &pool, uint32_t &read)
+    {
+        return readPacket(client, &pool, pool.getReadProgress(), read);
+    }
 }
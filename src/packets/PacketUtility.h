@@ -45,6 +45,8 @@
 #include "PingRequest.h"
 #include "PingResponse.h"
 #include "Publish.h"
+#include "PreparedPublish.h"
+#include "PacketPool.h"
 #include "PublishAcknowledge.h"
 #include "PublishComplete.h"
 #include "PublishReceived.h"
@@ -67,6 +69,25 @@ namespace CppMqtt
      */
     Packet *readPacketFromClient(Client *);
 
+    /**
+     * @brief Attempts to read a packet from the client using packets from a pool.
+     * Behaves as readPacketFromClient(Client *) but no packet is constructed, the returned
+     * packet belongs to the pool and must be handed back with PacketPool::release
+     * Read progress is kept in the pool, so each connection should use its own pool
+     *
+     * @param pool The pool supplying packets
+     * @return Packet* The processed packet, NULL if a complete packet has not been receieved.
+     */
+    Packet *readPacketFromClient(Client *, PacketPool &pool);
+    /**
+     * @brief Attempts to read a packet from the client using packets from a pool, counting the bytes read
+     *
+     * @param pool The pool supplying packets
+     * @param read Incremented by the amount of bytes taken from the client
+     * @return Packet* The processed packet, NULL if a complete packet has not been receieved.
+     */
+    Packet *readPacketFromClient(Client *, PacketPool &pool, uint32_t &read);
+
     // /**
     //  * @brief Constructs a packet from an identifier
     //  *
@@ -0,0 +1,201 @@
+/*
+ * File: PreparedPublish.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "packets/PreparedPublish.h"
+#include "packets/Packet.h"
+#include "utils/Utf8.h"
+
+using namespace CppMqtt;
+
+#define QOS_SHIFT 1
+#define RETAIN 0x1
+
+#define PACKET_IDENTIFIER_SIZE 2
+// Identifier and value of a message expiry interval property
+#define EXPIRY_PROPERTY_SIZE 5
+
+PreparedPublish::PreparedPublish(EncodedString &topic, QoS qos, bool retain, Properties *properties) : qos(qos)
+{
+    fixedHeader = PacketId::PUBLISH | (qos._to_integral() << QOS_SHIFT) | (retain ? RETAIN : 0);
+    topicValid = topic.validateTopicName();
+
+    if (properties)
+    {
+        Property *format = properties->get(PAYLOAD_FORMAT_INDICATOR);
+        utf8Payload = (format != NULL && ((ByteProperty *)format)->getValue() == 1);
+    }
+
+    VariableByteInteger emptyProperties(0);
+    size_t propertiesSize = properties ? properties->totalSize() : emptyProperties.size();
+
+    PacketBuffer buffer(topic.size() + propertiesSize);
+
+    identifierOffset = topic.push(buffer);
+
+    if (properties)
+    {
+        properties->push(buffer);
+    }
+    else
+    {
+        emptyProperties.push(buffer);
+    }
+
+    variableHeader.assign(buffer.getBuffer(), buffer.getBuffer() + buffer.getLength());
+
+    uint8_t *data = variableHeader.data();
+    size_t position = identifierOffset;
+
+    position += VariableByteInteger::decode(data + position, variableHeader.size() - position, propertiesLength);
+
+    // The expiry value is located so queued copies of the packet can have it rewritten
+    while (properties && properties->has(MESSAGE_EXPIRY_INTERVAL) && position < variableHeader.size())
+    {
+        uint32_t identifier = 0;
+        size_t consumed = VariableByteInteger::decode(data + position, variableHeader.size() - position, identifier);
+
+        if (consumed == 0)
+        {
+            break;
+        }
+
+        position += consumed;
+
+        int32_t length = Properties::valueSize(identifier, data + position, variableHeader.size() - position);
+
+        if (length < 0)
+        {
+            break;
+        }
+
+        if (identifier == MESSAGE_EXPIRY_INTERVAL)
+        {
+            expiryOffset = position;
+            messageExpiry = (data[position] << 24) | (data[position + 1] << 16) | (data[position + 2] << 8) | data[position + 3];
+            break;
+        }
+
+        position += length;
+    }
+}
+
+bool PreparedPublish::validate(Payload &payload)
+{
+    return topicValid && (!utf8Payload || isValidUtf8(payload.getData(), payload.size()));
+}
+
+uint32_t PreparedPublish::remainingLength(Payload &payload, uint32_t expiry)
+{
+    uint32_t length = variableHeader.size() + payload.size();
+
+    if (qos != +QoS::ZERO)
+    {
+        length += PACKET_IDENTIFIER_SIZE;
+    }
+
+    if (messageExpiry == 0 && expiry > 0)
+    {
+        // The added property, and the property length growing if it needs another byte
+        length += EXPIRY_PROPERTY_SIZE + VariableByteInteger::encodedSize(propertiesLength + EXPIRY_PROPERTY_SIZE) -
+                  VariableByteInteger::encodedSize(propertiesLength);
+    }
+
+    return length;
+}
+
+size_t PreparedPublish::totalSize(Payload &payload, uint32_t expiry)
+{
+    VariableByteInteger length(remainingLength(payload, expiry));
+    return 1 + length.size() + length;
+}
+
+size_t PreparedPublish::push(PacketBuffer &buffer, uint16_t packetIdentifier, Payload &payload)
+{
+    size_t valueOffset;
+    return push(buffer, packetIdentifier, payload, 0, valueOffset);
+}
+
+size_t PreparedPublish::push(PacketBuffer &buffer, uint16_t packetIdentifier, Payload &payload, uint32_t expiry, size_t &valueOffset)
+{
+    bool added = messageExpiry == 0 && expiry > 0;
+    VariableByteInteger length(remainingLength(payload, expiry));
+
+    // Fixed Header
+    size_t written = buffer.push(fixedHeader);
+    written += length.push(buffer);
+
+    written += buffer.push(variableHeader.data(), identifierOffset);
+
+    if (qos != +QoS::ZERO)
+    {
+        written += buffer.push(&packetIdentifier, PACKET_IDENTIFIER_SIZE);
+    }
+
+    valueOffset = 0;
+
+    if (added)
+    {
+        // The expiry goes in front of the cached properties, behind a new property length
+        VariableByteInteger lengthWithExpiry(propertiesLength + EXPIRY_PROPERTY_SIZE);
+        MessageExpiryIntervalProperty property(expiry);
+        size_t skipped = identifierOffset + VariableByteInteger::encodedSize(propertiesLength);
+
+        written += lengthWithExpiry.push(buffer);
+        written += property.push(buffer);
+        valueOffset = written - sizeof(uint32_t);
+        written += buffer.push(variableHeader.data() + skipped, variableHeader.size() - skipped);
+    }
+    else
+    {
+        if (messageExpiry > 0)
+        {
+            valueOffset = written + expiryOffset - identifierOffset;
+        }
+
+        written += buffer.push(variableHeader.data() + identifierOffset, variableHeader.size() - identifierOffset);
+    }
+
+    // Payload
+    written += payload.push(buffer);
+
+    return written;
+}
+
+QoS PreparedPublish::getQos()
+{
+    return qos;
+}
+
+bool PreparedPublish::getRetain()
+{
+    return fixedHeader & RETAIN;
+}
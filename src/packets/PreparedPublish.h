@@ -0,0 +1,139 @@
+/*
+ * File: PreparedPublish.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef SRC_PACKETS_PREPAREDPUBLISH
+#define SRC_PACKETS_PREPAREDPUBLISH
+
+#include <stdint.h>
+#include <vector>
+#include "MqttProperties.h"
+#include "PacketBuffer.h"
+#include "types/EncodedString.h"
+#include "types/Payload.h"
+#include "types/Common.h"
+
+namespace CppMqtt
+{
+    /**
+     * @brief A reusable handle for publishing to a fixed topic
+     * The topic and properties are encoded once on construction, publishing through the handle
+     * only writes the remaining length, packet identifier and payload around the cached bytes
+     */
+    class PreparedPublish
+    {
+    private:
+        uint8_t fixedHeader;
+        QoS qos;
+        // Encoded topic followed by the encoded properties
+        vector<uint8_t> variableHeader;
+        // Offset where the packet identifier is inserted for QoS 1 and 2, the properties follow it
+        size_t identifierOffset = 0;
+        // Length of the encoded property block, excluding its own length
+        uint32_t propertiesLength = 0;
+        // Message expiry interval from the properties and the offset of its value, 0 when there is none
+        uint32_t messageExpiry = 0;
+        size_t expiryOffset = 0;
+        bool topicValid;
+        // Whether the properties declare the payload as UTF-8
+        bool utf8Payload = false;
+
+        uint32_t remainingLength(Payload &payload, uint32_t expiry);
+
+    protected:
+    public:
+        /**
+         * @brief Encodes the variable header of a Publish Packet for reuse
+         *
+         * @param topic The topic to publish with
+         * @param qos The QOS of the publish
+         * @param retain Whether published payloads are retained
+         * @param properties Properties to publish with, they are encoded immediately and not retained
+         */
+        PreparedPublish(EncodedString &topic, QoS qos, bool retain = false, Properties *properties = NULL);
+
+        /**
+         * @brief Returns the byte size of the complete packet for a payload
+         *
+         * @param payload
+         * @param expiry Message expiry interval added when the properties have none, 0 adds nothing
+         * @return size_t
+         */
+        size_t totalSize(Payload &payload, uint32_t expiry = 0);
+        /**
+         * @brief Pushes a complete Publish Packet to a buffer using the pre-encoded header
+         *
+         * @param buffer The buffer to push data to
+         * @param packetIdentifier The packet identifier, ignored for QoS 0
+         * @param payload The payload to publish
+         * @return size_t The amount of bytes written
+         */
+        size_t push(PacketBuffer &buffer, uint16_t packetIdentifier, Payload &payload);
+        /**
+         * @brief Pushes a complete Publish Packet, adding a message expiry interval when the properties have none
+         *
+         * @param buffer The buffer to push data to
+         * @param packetIdentifier The packet identifier, ignored for QoS 0
+         * @param payload The payload to publish
+         * @param expiry Message expiry interval to add, 0 adds nothing
+         * @param valueOffset Set to the offset of the expiry value from the start of the packet, 0 when it has none
+         * @return size_t The amount of bytes written
+         */
+        size_t push(PacketBuffer &buffer, uint16_t packetIdentifier, Payload &payload, uint32_t expiry, size_t &valueOffset);
+
+        /**
+         * @brief Checks the topic, and payloads declared as UTF-8, are well formed
+         *
+         * @param payload The payload to be published
+         * @return true
+         * @return false
+         */
+        bool validate(Payload &payload);
+
+        QoS getQos();
+        /**
+         * @brief Returns the message expiry interval the publish was prepared with
+         *
+         * @return uint32_t 0 if the properties have none
+         */
+        uint32_t getMessageExpiry() { return messageExpiry; };
+        /**
+         * @brief Returns the topic name, without its length prefix
+         *
+         * @return const char*
+         */
+        const char *getTopic() { return (const char *)variableHeader.data() + 2; };
+        uint16_t getTopicLength() { return identifierOffset - 2; };
+        bool getRetain();
+    };
+}
+
+#endif /* SRC_PACKETS_PREPAREDPUBLISH */
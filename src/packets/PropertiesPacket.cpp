@@ -33,6 +33,12 @@
 
 using namespace CppMqtt;
 
+void PropertiesPacket::reset(uint8_t fixedHeaderByte)
+{
+    Packet::reset(fixedHeaderByte);
+    properties.clear();
+}
+
 EncodedString PropertiesPacket::getUserProperty(EncodedString key)
 {
     EncodedString value;
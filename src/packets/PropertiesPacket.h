@@ -23,6 +23,14 @@ namespace CppMqtt
         PropertiesPacket(FixedHeader fixedHeader) : Packet(fixedHeader){};
         EncodedString getUserProperty(EncodedString key);
         EncodedString getUserProperty(const char *key, uint32_t keyLength);
+        Properties &getProperties() { return properties; };
+        /**
+         * @brief Returns the packet to a freshly constructed state so it can be reused
+         *
+         * @param fixedHeaderByte
+         */
+        virtual void reset(uint8_t fixedHeaderByte) override;
+        virtual bool malformed() override { return properties.isMalformed(); };
     };
 
 }
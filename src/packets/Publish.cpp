@@ -30,6 +30,7 @@
  */
 
 #include "packets/Publish.h"
+#include "utils/Utf8.h"
 
 using namespace CppMqtt;
 
@@ -50,14 +51,19 @@ enum ReadingState
 #define RETAIN_FLAGS 0x1
 #define RETAIN 0x1
 
+#define DUPLICATE_FLAGS 0x8
+
 #define PACKET_IDENTIFIER_SIZE 2
 
 Publish::Publish() : PropertiesPacket(PacketId::PUBLISH)
 {
+    // Most subscribers never read message properties
+    properties.setLazy(true);
 }
 
 Publish::Publish(uint8_t flags) : PropertiesPacket(PacketId::PUBLISH | (flags & HEADER_BYTES_MASK))
 {
+    properties.setLazy(true);
 }
 
 QoS Publish::getQos()
@@ -93,6 +99,11 @@ bool Publish::getRetain()
     return (getFixedHeaderFlags() & RETAIN_FLAGS);
 }
 
+bool Publish::getDuplicate()
+{
+    return (getFixedHeaderFlags() & DUPLICATE_FLAGS);
+}
+
 bool Publish::readFromClient(Client *client, uint32_t &bytes)
 {
 
@@ -125,7 +136,7 @@ bool Publish::readFromClient(Client *client, uint32_t &bytes)
             if (!properties.readFromClient(client, read))
             {
                 state = VARIABLE_HEADER_PAYLOAD;
-                payload = Payload(getRemainingLength() - read);
+                payload.allocate(getRemainingLength() - read);
             }
             break;
         case VARIABLE_HEADER_PAYLOAD:
@@ -140,6 +151,11 @@ bool Publish::readFromClient(Client *client, uint32_t &bytes)
 
         readBytes(read);
         bytes += read;
+
+        if (read == 0)
+        {
+            break;
+        }
     }
 
     return dataRemaining();
@@ -201,7 +217,7 @@ void Publish::setTopic(const char *data, uint32_t length)
 
 void Publish::setTopic(EncodedString value)
 {
-    topic = value;
+    topic = std::move(value);
 }
 
 void Publish::setPayload(void *data, uint32_t length)
@@ -211,7 +227,7 @@ void Publish::setPayload(void *data, uint32_t length)
 
 void Publish::setPayload(Payload value)
 {
-    payload = value;
+    payload = std::move(value);
 }
 
 uint16_t Publish::getPacketIdentifier()
@@ -246,5 +262,25 @@ void Publish::setQos(QoS qos)
 
 bool Publish::validate()
 {
-    return true;
+    // An empty topic is only permitted when a topic alias is used in its place
+    if (!topic.validateTopicName() && !(topic.size() == 2 && properties.has(TOPIC_ALIAS)))
+    {
+        return false;
+    }
+
+    return !hasUtf8Payload() || isValidUtf8(payload.getData(), payload.size());
+}
+
+bool Publish::hasUtf8Payload()
+{
+    Property *format = properties.get(PAYLOAD_FORMAT_INDICATOR);
+
+    return (format != NULL && ((PayloadFormatIndicatorProperty *)format)->getValue() == 1);
+}
+
+void Publish::reset(uint8_t fixedHeaderByte)
+{
+    PropertiesPacket::reset(fixedHeaderByte);
+    state = IDLE;
+    packetIdentifier = 0;
 }
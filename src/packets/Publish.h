@@ -86,13 +86,28 @@ namespace CppMqtt
         QoS getQos();
         void setRetain(bool value);
         bool getRetain();
+        bool getDuplicate();
+        /**
+         * @brief Returns whether the payload format indicator marks the payload as UTF-8
+         *
+         * @return true
+         * @return false
+         */
+        bool hasUtf8Payload();
         /**
          * @brief Validates the packet to the MQTT 5 standards
+         * The topic must be well formed UTF-8, as must the payload when it is marked as UTF-8
          *
          * @return true
          * @return false
          */
         virtual bool validate() override;
+        /**
+         * @brief Returns the packet to a freshly constructed state so it can be reused
+         *
+         * @param fixedHeaderByte
+         */
+        virtual void reset(uint8_t fixedHeaderByte) override;
     };
 
 }
@@ -45,10 +45,20 @@ enum ReadingState
     COMPLETE
 };
 
-size_t ReasonsAcknowledge::push([[maybe_unused]] PacketBuffer &buffer)
+size_t ReasonsAcknowledge::push(PacketBuffer &buffer)
 {
-    // Not Required
-    return 0;
+    // Fixed Header
+    size_t written = Packet::push(buffer);
+
+    written += buffer.push(&packetIdentifier, PACKET_IDENTIFIER_SIZE);
+    written += properties.push(buffer);
+
+    if (reasonCodes.size() > 0)
+    {
+        written += buffer.push(reasonCodes.data(), reasonCodes.size());
+    }
+
+    return written;
 }
 
 bool ReasonsAcknowledge::readFromClient(Client *client, uint32_t &bytes)
@@ -90,9 +100,14 @@ bool ReasonsAcknowledge::readFromClient(Client *client, uint32_t &bytes)
         }
 
         readBytes(read);
+
+        if (read == 0)
+        {
+            break;
+        }
     }
 
-    bytes += getRemainingLength() - start;
+    bytes += start - getRemainingLength();
 
     if (!dataRemaining())
     {
@@ -107,12 +122,30 @@ size_t ReasonsAcknowledge::size()
     return PACKET_IDENTIFIER_SIZE + properties.totalSize() + reasonCodes.size();
 }
 
-vector<uint8_t> ReasonsAcknowledge::getReasonCodes()
+const vector<uint8_t> &ReasonsAcknowledge::getReasonCodes()
 {
     return reasonCodes;
 }
 
+void ReasonsAcknowledge::addReasonCode(uint8_t reasonCode)
+{
+    reasonCodes.push_back(reasonCode);
+}
+
 uint16_t ReasonsAcknowledge::getPacketIdentifier()
 {
     return packetIdentifier;
-}
\ No newline at end of file
+}
+
+void ReasonsAcknowledge::setPacketIdentifier(uint16_t packetIdentifier)
+{
+    this->packetIdentifier = packetIdentifier;
+}
+
+void ReasonsAcknowledge::reset(uint8_t fixedHeaderByte)
+{
+    PropertiesPacket::reset(fixedHeaderByte);
+    state = IDLE;
+    packetIdentifier = 0;
+    reasonCodes.clear();
+}
@@ -71,8 +71,16 @@ namespace CppMqtt
         virtual bool readFromClient(Client *client, uint32_t &read) override;
         size_t size();
 
-        vector<uint8_t> getReasonCodes();
+        const vector<uint8_t> &getReasonCodes();
+        void addReasonCode(uint8_t reasonCode);
         uint16_t getPacketIdentifier();
+        void setPacketIdentifier(uint16_t packetIdentifier);
+        /**
+         * @brief Returns the packet to a freshly constructed state so it can be reused
+         *
+         * @param fixedHeaderByte
+         */
+        virtual void reset(uint8_t fixedHeaderByte) override;
     };
 }
 
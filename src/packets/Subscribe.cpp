@@ -45,5 +45,5 @@ Subscribe::Subscribe(uint8_t flags) : Subscription(PacketId::SUBSCRIBE | (flags
 
 bool Subscribe::validate()
 {
-    return true;
+    return validatePayloads();
 }
\ No newline at end of file
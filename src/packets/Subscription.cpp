@@ -77,6 +77,24 @@ bool Subscription::readFromClient([[maybe_unused]] Client *client, [[maybe_unuse
     return false;
 }
 
+bool Subscription::validatePayloads()
+{
+    if (payloads.empty())
+    {
+        return false;
+    }
+
+    for (auto &payload : payloads)
+    {
+        if (!payload->validate())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void Subscription::addPayload(SubscriptionPayload *payload)
 {
     payloads.push_back(payload);
@@ -53,6 +53,13 @@ namespace CppMqtt
 
     protected:
         Subscription(uint8_t fixedHeaderByte) : PropertiesPacket(fixedHeaderByte){};
+        /**
+         * @brief Checks there is at least one payload and every topic filter is valid
+         *
+         * @return true
+         * @return false
+         */
+        bool validatePayloads();
 
     public:
         size_t size();
@@ -45,5 +45,5 @@ Unsubscribe::Unsubscribe(uint8_t flags) : Subscription(PacketId::UNSUBSCRIBE | (
 
 bool Unsubscribe::validate()
 {
-    return true;
+    return validatePayloads();
 }
\ No newline at end of file
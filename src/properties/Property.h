@@ -35,6 +35,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include "ClientInteractor.h"
+#include "Allocator.h"
 #include "types/VariableByteInteger.h"
 
 /** The one byte  V5 property indicator */
@@ -103,6 +104,12 @@ namespace CppMqtt
         };
         virtual ~Property(){};
 
+        // Heap properties are reserved through the default Allocator, arena properties use placement new
+        static void *operator new(size_t size) { return allocateObject(size); }
+        static void *operator new(size_t, void *pointer) { return pointer; }
+        static void operator delete(void *pointer) { deallocateObject(pointer); }
+        static void operator delete(void *, void *) {}
+
         VariableByteInteger getIdentifier()
         {
             return identifier;
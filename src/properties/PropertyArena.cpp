@@ -0,0 +1,178 @@
+/*
+ * File: PropertyArena.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "properties/PropertyArena.h"
+#include <stdlib.h>
+#include <utility>
+
+#define ARENA_ALIGNMENT alignof(max_align_t)
+
+using namespace CppMqtt;
+
+PropertyArena::PropertyArena(PropertyArena &&source)
+    : block(source.block), capacity(source.capacity), used(source.used), allocator(source.allocator),
+      overflow(std::move(source.overflow))
+{
+    source.block = NULL;
+    source.capacity = 0;
+    source.used = 0;
+    source.allocator = NULL;
+    source.overflow.clear();
+}
+
+PropertyArena &PropertyArena::operator=(PropertyArena &&right)
+{
+    if (&right != this)
+    {
+        release();
+        block = right.block;
+        capacity = right.capacity;
+        used = right.used;
+        allocator = right.allocator;
+        overflow = std::move(right.overflow);
+        right.block = NULL;
+        right.capacity = 0;
+        right.used = 0;
+        right.allocator = NULL;
+        right.overflow.clear();
+    }
+    return *this;
+}
+
+PropertyArena::~PropertyArena()
+{
+    release();
+}
+
+void PropertyArena::release()
+{
+    if (allocator != NULL)
+    {
+        allocator->deallocate(block, capacity);
+
+        for (auto &entry : overflow)
+        {
+            allocator->deallocate(entry.first, entry.second);
+        }
+    }
+
+    block = NULL;
+    capacity = 0;
+    used = 0;
+    overflow.clear();
+}
+
+void *PropertyArena::allocate(size_t size)
+{
+    size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+    if (block == NULL)
+    {
+        capacity = (size > PROPERTY_ARENA_SIZE) ? size : PROPERTY_ARENA_SIZE;
+        allocator = getDefaultAllocator();
+        block = (uint8_t *)allocateFrom(allocator, capacity);
+        used = 0;
+
+        if (block == NULL)
+        {
+            capacity = 0;
+            return NULL;
+        }
+    }
+
+    if (used + size <= capacity)
+    {
+        void *result = block + used;
+        used += size;
+        return result;
+    }
+
+    // Retire the full block and continue in a new one, the blocks are merged on the next rewind
+    size_t next = (size > capacity) ? size : capacity;
+    uint8_t *memory = (uint8_t *)allocateFrom(allocator, next);
+
+    if (memory == NULL)
+    {
+        return NULL;
+    }
+
+    overflow.push_back({block, capacity});
+    block = memory;
+    capacity = next;
+    used = size;
+
+    return block;
+}
+
+bool PropertyArena::owns(const void *pointer) const
+{
+    const uint8_t *address = (const uint8_t *)pointer;
+
+    if (block != NULL && address >= block && address < block + capacity)
+    {
+        return true;
+    }
+
+    for (auto &entry : overflow)
+    {
+        if (address >= entry.first && address < entry.first + entry.second)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PropertyArena::rewind()
+{
+    used = 0;
+
+    if (overflow.empty())
+    {
+        return;
+    }
+
+    size_t total = capacity;
+
+    for (auto &entry : overflow)
+    {
+        total += entry.second;
+        allocator->deallocate(entry.first, entry.second);
+    }
+
+    overflow.clear();
+
+    allocator->deallocate(block, capacity);
+    block = (uint8_t *)allocateFrom(allocator, total);
+    capacity = (block != NULL) ? total : 0;
+}
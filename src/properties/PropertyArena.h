@@ -0,0 +1,100 @@
+/*
+ * File: PropertyArena.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef PROPERTYARENA
+#define PROPERTYARENA
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "Allocator.h"
+
+// Size of the first block reserved when a property is decoded
+#ifndef PROPERTY_ARENA_SIZE
+#define PROPERTY_ARENA_SIZE 512
+#endif
+
+namespace CppMqtt
+{
+    /**
+     * @brief Bump allocator holding the decoded properties of a property block
+     * Memory is reserved in a single block and handed out sequentially. When a block runs out it is
+     * retired and a new block is started, on the next rewind the blocks are merged so that a repeated
+     * property block of the same shape is served from one allocation, or none once warm.
+     * Objects are not destroyed by the arena, the owner must destroy them before rewinding.
+     */
+    class PropertyArena
+    {
+    private:
+        uint8_t *block = NULL;
+        size_t capacity = 0;
+        size_t used = 0;
+        // Allocator the blocks were reserved from
+        Allocator *allocator = NULL;
+        // Full blocks retired since the last rewind
+        std::vector<std::pair<uint8_t *, size_t>> overflow;
+
+        void release();
+
+    protected:
+    public:
+        PropertyArena(){};
+        PropertyArena(const PropertyArena &) = delete;
+        PropertyArena(PropertyArena &&source);
+        PropertyArena &operator=(const PropertyArena &) = delete;
+        PropertyArena &operator=(PropertyArena &&right);
+        ~PropertyArena();
+
+        /**
+         * @brief Reserves memory suitable for any object type
+         *
+         * @param size The amount of bytes required
+         * @return void* The reserved memory, NULL if the allocation failed
+         */
+        void *allocate(size_t size);
+        /**
+         * @brief Returns whether a pointer was reserved by this arena
+         *
+         * @param pointer
+         * @return true
+         * @return false
+         */
+        bool owns(const void *pointer) const;
+        /**
+         * @brief Makes all reserved memory available again
+         * Any overflow blocks are merged into the main block
+         */
+        void rewind();
+    };
+}
+
+#endif /* PROPERTYARENA */
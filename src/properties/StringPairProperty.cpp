@@ -53,7 +53,7 @@ StringPairProperty::StringPairProperty(PropertyCodes identifier)
 }
 
 StringPairProperty::StringPairProperty(PropertyCodes identifier, EncodedString key, EncodedString value)
-    : Property(identifier), key(key), value(value)
+    : Property(identifier), key(std::move(key)), value(std::move(value))
 {
     state = IDLE;
 }
@@ -91,7 +91,7 @@ size_t StringPairProperty::pushProperty(PacketBuffer &buffer)
 
 void StringPairProperty::setKey(EncodedString key)
 {
-    this->key = key;
+    this->key = std::move(key);
 }
 
 EncodedString &StringPairProperty::getKey()
@@ -102,7 +102,7 @@ EncodedString &StringPairProperty::getKey()
 
 void StringPairProperty::setValue(EncodedString value)
 {
-    this->value = value;
+    this->value = std::move(value);
 }
 
 EncodedString &StringPairProperty::getValue()
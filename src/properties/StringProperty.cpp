@@ -44,7 +44,7 @@ StringProperty::StringProperty(PropertyCodes identifier)
 }
 
 StringProperty::StringProperty(PropertyCodes identifier, EncodedString value)
-    : Property(identifier), value(value)
+    : Property(identifier), value(std::move(value))
 {
 }
 
@@ -70,7 +70,7 @@ size_t StringProperty::pushProperty(PacketBuffer &buffer)
 
 void StringProperty::setValue(EncodedString value)
 {
-    this->value = value;
+    this->value = std::move(value);
 }
 
 EncodedString StringProperty::getValue()
@@ -43,4 +43,8 @@ BinaryData::BinaryData(const char *string, uint16_t length) : BufferData(string,
 
 BinaryData::BinaryData(const BufferData &source) : BufferData(source)
 {
+}
+
+BinaryData::BinaryData(BufferData &&source) : BufferData(std::move(source))
+{
 }
\ No newline at end of file
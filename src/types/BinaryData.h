@@ -46,6 +46,7 @@ namespace CppMqtt
         BinaryData();
         BinaryData(const char *, uint16_t);
         BinaryData(const BufferData &);
+        BinaryData(BufferData &&);
     };
 }
 
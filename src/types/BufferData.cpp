@@ -57,14 +57,7 @@ BufferData::BufferData()
 BufferData::BufferData(const char *string, uint16_t length)
 {
     state = IDLE;
-#ifdef STATIC_MEMORY
-    if (length > MAX_BUFFER_SIZE)
-    {
-        throw std::logic_error("Required Buffer size greater than available.");
-    }
-#else
-    data = (char *)malloc(length);
-#endif
+    allocate(length);
     memcpy(data, string, length);
     this->length = length;
 }
@@ -72,66 +65,60 @@ BufferData::BufferData(const char *string, uint16_t length)
 BufferData::BufferData(const BufferData &source)
 {
     state = source.state;
-#ifndef STATIC_MEMORY
-    if (data)
-    {
-        free(data);
-    }
-#endif
 
     if (source.data)
     {
-#ifndef STATIC_MEMORY
-        data = (char *)malloc(source.length);
-#endif
+        allocate(source.length);
         memcpy(data, source.data, source.length);
     }
-    else
-    {
-#ifndef STATIC_MEMORY
-        data = NULL;
-#endif
-    }
 
     length = source.length;
 }
 
+BufferData::BufferData(BufferData &&source)
+{
+    state = source.state;
+    length = source.length;
+    take(source);
+}
+
 BufferData &BufferData::operator=(const BufferData &right)
 {
     if (&right != this)
     {
-#ifndef STATIC_MEMORY
-        if (data)
-        {
-            free(data);
-        }
-#endif
+        deallocate();
 
         state = right.state;
 
         if (right.data)
         {
             length = right.length;
-#ifndef STATIC_MEMORY
-            data = (char *)malloc(right.length);
-#endif
-
+            allocate(right.length);
             memcpy(data, right.data, length);
         }
         else
         {
             length = 0;
-#ifndef STATIC_MEMORY
-            data = NULL;
-#endif
         }
     }
     return *this;
 }
 
+BufferData &BufferData::operator=(BufferData &&right)
+{
+    if (&right != this)
+    {
+        deallocate();
+        state = right.state;
+        length = right.length;
+        take(right);
+    }
+    return *this;
+}
+
 bool BufferData::operator==(const BufferData &right)
 {
-    return (length == right.length && memcmp(data, right.data, length));
+    return (length == right.length && memcmp(data, right.data, length) == 0);
 }
 
 bool BufferData::operator!=(const BufferData &right)
@@ -140,16 +127,68 @@ bool BufferData::operator!=(const BufferData &right)
 }
 
 BufferData::~BufferData()
+{
+    deallocate();
+}
+
+void BufferData::allocate(uint16_t size)
+{
+#ifdef STATIC_MEMORY
+    if (size > MAX_BUFFER_SIZE)
+    {
+        throw std::logic_error("Required Buffer size greater than available.");
+    }
+#else
+    // Short strings live in the inline buffer, only long strings touch the heap
+    if (size <= BUFFER_DATA_INLINE_SIZE)
+    {
+        data = inlineData;
+    }
+    else
+    {
+        allocator = getDefaultAllocator();
+        data = (char *)allocateFrom(allocator, size);
+        capacity = size;
+    }
+#endif
+}
+
+void BufferData::deallocate()
 {
 #ifndef STATIC_MEMORY
-    if (data)
+    if (data && data != inlineData)
     {
-        free(data);
-        data = NULL;
+        allocator->deallocate(data, capacity);
     }
+    data = NULL;
+    allocator = NULL;
+    capacity = 0;
 #endif
 }
 
+void BufferData::take(BufferData &source)
+{
+#ifdef STATIC_MEMORY
+    memcpy(data, source.data, length);
+#else
+    if (source.data == source.inlineData)
+    {
+        data = inlineData;
+        memcpy(data, source.data, length);
+    }
+    else
+    {
+        data = source.data;
+        allocator = source.allocator;
+        capacity = source.capacity;
+    }
+    source.data = NULL;
+    source.allocator = NULL;
+    source.capacity = 0;
+#endif
+    source.length = 0;
+}
+
 size_t BufferData::push(PacketBuffer &buffer)
 {
     length.push(buffer);
@@ -172,15 +211,7 @@ bool BufferData::readFromClient(Client *client, uint32_t &read)
     if (state == IDLE)
     {
         state = LENGTH;
-#ifdef STATIC_MEMORY
-        // memset(data, 0, MAX_BUFFER_SIZE);
-#else
-        if (data != NULL)
-        {
-            free(data);
-            data = NULL;
-        }
-#endif
+        deallocate();
     }
 
     if (state == LENGTH && (size_t)client->available() >= STRING_LENGTH_SIZE)
@@ -189,14 +220,7 @@ bool BufferData::readFromClient(Client *client, uint32_t &read)
         state = DATA;
         if (length > 0)
         {
-#ifdef STATIC_MEMORY
-            if (length > MAX_BUFFER_SIZE)
-            {
-                throw std::logic_error("Required Buffer size greater than available.");
-            }
-#else
-            data = (char *)malloc(length);
-#endif
+            allocate(length);
             memset(data, 0, length);
         }
     }
@@ -32,8 +32,16 @@
 #ifndef BUFFERDATA
 #define BUFFERDATA
 
+#include <utility>
 #include "ClientInteractor.h"
 #include "types/BigEndianInt.h"
+#include "Allocator.h"
+
+// Buffers up to this size are stored inline rather than on the heap
+// CMake builds get the value from CPP_MQTT_INLINE_BUFFER_SIZE, other builds must define the same value for every file
+#ifndef BUFFER_DATA_INLINE_SIZE
+#define BUFFER_DATA_INLINE_SIZE 64
+#endif
 
 namespace CppMqtt
 {
@@ -45,6 +53,31 @@ namespace CppMqtt
     {
         uint16_t state;
 
+#ifndef STATIC_MEMORY
+        char inlineData[BUFFER_DATA_INLINE_SIZE];
+        // Allocator and size of heap storage, unused while the data is inline
+        Allocator *allocator = NULL;
+        uint16_t capacity = 0;
+#endif
+
+        /**
+         * @brief Points data at storage large enough for a buffer of the given size
+         *
+         * @param size
+         */
+        void allocate(uint16_t size);
+        /**
+         * @brief Frees any heap storage held by the buffer
+         */
+        void deallocate();
+        /**
+         * @brief Takes the contents of another buffer, leaving it empty
+         * The length must already be set to the length of the source
+         *
+         * @param source
+         */
+        void take(BufferData &source);
+
     public:
         BigEndianInt<uint16_t> length = 0;
 #ifdef STATIC_MEMORY
@@ -56,7 +89,9 @@ namespace CppMqtt
         BufferData();
         BufferData(const char *, uint16_t);
         BufferData(const BufferData &);
+        BufferData(BufferData &&);
         BufferData &operator=(const BufferData &right);
+        BufferData &operator=(BufferData &&right);
         bool operator==(const BufferData &right);
         bool operator!=(const BufferData &right);
 
@@ -30,6 +30,8 @@
  */
 
 #include "types/EncodedString.h"
+#include "utils/Utf8.h"
+#include "utils/Topic.h"
 
 using namespace CppMqtt;
 
@@ -43,4 +45,23 @@ EncodedString::EncodedString(const char *string, uint16_t length) : BufferData(s
 
 EncodedString::EncodedString(const BufferData &source) : BufferData(source)
 {
+}
+
+EncodedString::EncodedString(BufferData &&source) : BufferData(std::move(source))
+{
+}
+
+bool EncodedString::validate()
+{
+    return isValidUtf8((const uint8_t *)data, length, false);
+}
+
+bool EncodedString::validateTopicName()
+{
+    return isValidTopicName(data, length);
+}
+
+bool EncodedString::validateTopicFilter()
+{
+    return isValidTopicFilter(data, length);
 }
\ No newline at end of file
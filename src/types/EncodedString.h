@@ -46,6 +46,29 @@ namespace CppMqtt
         EncodedString();
         EncodedString(const char *, uint16_t);
         EncodedString(const BufferData &);
+        EncodedString(BufferData &&);
+
+        /**
+         * @brief Checks the string is well formed UTF-8 without null characters, as MQTT 5 requires
+         *
+         * @return true
+         * @return false
+         */
+        bool validate();
+        /**
+         * @brief Checks the string is a valid topic name for publishing
+         *
+         * @return true
+         * @return false
+         */
+        bool validateTopicName();
+        /**
+         * @brief Checks the string is a valid topic filter for subscribing
+         *
+         * @return true
+         * @return false
+         */
+        bool validateTopicFilter();
     };
 }
 
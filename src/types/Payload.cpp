@@ -38,12 +38,17 @@ Payload::Payload()
 {
 }
 
+Payload::Payload(void *data, uint32_t length, PayloadRelease release)
+    : data((uint8_t *)data), length(length), release(std::move(release))
+{
+}
+
 Payload::Payload(const Payload &payload)
 {
     if (payload.data)
     {
         length = payload.length;
-        data = (uint8_t *)malloc(payload.length);
+        reserve(payload.length);
         memcpy(data, payload.data, length);
     }
     else
@@ -56,7 +61,7 @@ Payload::Payload(const Payload &payload)
 Payload::Payload(uint32_t length)
 {
     this->length = length;
-    data = (uint8_t *)malloc(length);
+    reserve(length);
 }
 
 Payload::Payload(void *data, uint32_t length) : Payload(length)
@@ -64,12 +69,65 @@ Payload::Payload(void *data, uint32_t length) : Payload(length)
     memcpy(this->data, data, length);
 }
 
+Payload::Payload(Payload &&payload)
+    : data(payload.data), length(payload.length), bytesRead(payload.bytesRead),
+      capacity(payload.capacity), allocator(payload.allocator), ownership(payload.ownership), release(std::move(payload.release))
+{
+    payload.data = NULL;
+    payload.length = 0;
+    payload.bytesRead = 0;
+    payload.capacity = 0;
+    payload.allocator = NULL;
+    payload.release = nullptr;
+}
+
 Payload::~Payload()
+{
+    reset();
+}
+
+void Payload::reset()
 {
     if (data && ownership)
     {
-        free(data);
+        if (release)
+        {
+            release(data, length);
+        }
+        else if (allocator)
+        {
+            allocator->deallocate(data, capacity);
+        }
+        else
+        {
+            free(data);
+        }
+    }
+
+    data = NULL;
+    release = nullptr;
+    ownership = true;
+    capacity = 0;
+    allocator = NULL;
+}
+
+void Payload::reserve(uint32_t size)
+{
+    allocator = getDefaultAllocator();
+    data = (uint8_t *)allocateFrom(allocator, size);
+    capacity = size;
+}
+
+void Payload::allocate(uint32_t length)
+{
+    if (!(data && ownership && allocator && capacity >= length))
+    {
+        reset();
+        reserve(length);
     }
+
+    this->length = length;
+    bytesRead = 0;
 }
 
 Payload Payload::wrap(void *data, uint32_t length)
@@ -85,15 +143,12 @@ Payload &Payload::operator=(const Payload &right)
 {
     if (&right != this)
     {
-        if (data)
-        {
-            free(data);
-        }
+        reset();
 
         if (right.data)
         {
             length = right.length;
-            data = (uint8_t *)malloc(right.length);
+            reserve(right.length);
             memcpy(data, right.data, length);
         }
         else
@@ -105,6 +160,31 @@ Payload &Payload::operator=(const Payload &right)
     return *this;
 }
 
+Payload &Payload::operator=(Payload &&right)
+{
+    if (&right != this)
+    {
+        reset();
+
+        data = right.data;
+        length = right.length;
+        bytesRead = right.bytesRead;
+        capacity = right.capacity;
+        allocator = right.allocator;
+        ownership = right.ownership;
+        release = std::move(right.release);
+
+        right.data = NULL;
+        right.length = 0;
+        right.bytesRead = 0;
+        right.capacity = 0;
+        right.allocator = NULL;
+        right.ownership = true;
+        right.release = nullptr;
+    }
+    return *this;
+}
+
 uint8_t *Payload::getData()
 {
     return data;
@@ -33,10 +33,17 @@
 #define PAYLOAD
 
 #include <stdint.h>
+#include <functional>
 #include "ClientInteractor.h"
+#include "Allocator.h"
 
 namespace CppMqtt
 {
+    /**
+     * @brief Called when a Payload releases a buffer handed over by the caller
+     */
+    typedef std::function<void(uint8_t *data, uint32_t length)> PayloadRelease;
+
     /**
      * @brief Represents a MQTT 5 Publish Payloads
      * Used for reading and writing an array of bytes to a communication client
@@ -47,23 +54,58 @@ namespace CppMqtt
         uint8_t *data = NULL;
         uint32_t length = 0;
         uint32_t bytesRead = 0;
+        // Size of a buffer created by allocate that can be reused
+        uint32_t capacity = 0;
+        // Allocator the buffer was reserved from, NULL when the buffer was handed over by the caller
+        Allocator *allocator = NULL;
         bool ownership = true;
+        PayloadRelease release;
+
+        /**
+         * @brief Frees or releases the current buffer depending on its ownership
+         */
+        void reset();
+        /**
+         * @brief Reserves a new owned buffer of the given size from the default Allocator
+         *
+         * @param size
+         */
+        void reserve(uint32_t size);
 
     protected:
     public:
         Payload();
         Payload(uint32_t length);
         Payload(void *data, uint32_t length);
+        /**
+         * @brief Takes ownership of a buffer without copying it
+         * The release callback is invoked once the Payload is finished with the buffer
+         *
+         * @param data The buffer to hand over
+         * @param length The length of the buffer
+         * @param release Callback used to release the buffer
+         */
+        Payload(void *data, uint32_t length, PayloadRelease release);
         Payload(const Payload &payload);
-        ~Payload();
+        Payload(Payload &&payload);
+        virtual ~Payload();
 
         static Payload wrap(void *data, uint32_t length);
 
         Payload &operator=(const Payload &right);
+        Payload &operator=(Payload &&right);
 
         uint8_t operator[](int i) const { return data[i]; }
         uint8_t &operator[](int i) { return data[i]; }
 
+        /**
+         * @brief Prepares the Payload to read a new payload of the given length
+         * Reuses the current buffer when it is large enough
+         *
+         * @param length
+         */
+        void allocate(uint32_t length);
+
         uint8_t *getData();
         void setData(void *data, uint32_t length);
         size_t size();
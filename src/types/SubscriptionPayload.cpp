@@ -52,9 +52,16 @@ size_t SubscriptionPayload::size()
 void SubscriptionPayload::setTopic(EncodedString &topic)
 {
     this->topic = EncodedString(topic);
+    topicValid = this->topic.validateTopicFilter();
 }
 
 void SubscriptionPayload::setTopic(const char *data, uint16_t length)
 {
     this->topic = EncodedString(data, length);
+    topicValid = this->topic.validateTopicFilter();
+}
+
+bool SubscriptionPayload::validate()
+{
+    return topicValid;
 }
\ No newline at end of file
@@ -49,6 +49,8 @@ namespace CppMqtt
     {
     private:
         EncodedString topic;
+        // Checked once when the topic is set
+        bool topicValid = false;
 
     protected:
     public:
@@ -75,6 +77,13 @@ namespace CppMqtt
 
         void setTopic(EncodedString &topic);
         void setTopic(const char *data, uint16_t length);
+        /**
+         * @brief Returns whether the topic is a valid topic filter
+         *
+         * @return true
+         * @return false
+         */
+        bool validate();
     };
 
 }
@@ -35,52 +35,113 @@
 
 #include "types/VariableByteInteger.h"
 
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 using namespace CppMqtt;
 
 #define LOWER_SEVEN_BITS 0x7F
+#define SEVEN_BIT_LANES 0x7F7F7F7F
+#define CONTINUATION_BITS 0x80808080
 
-VariableByteInteger::VariableByteInteger()
+// Continuation bits for each encoded length, every byte but the last is flagged
+static const uint32_t CONTINUATION_MASKS[] = {0, 0, 0x80, 0x8080, 0x808080};
+// Bytes covered by each encoded length
+static const uint32_t LENGTH_MASKS[] = {0, 0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+
+/**
+ * @brief Spreads the lower 28 bits of a value into four 7 bit lanes
+ */
+static inline uint32_t deposit(uint32_t value)
 {
+#if defined(__BMI2__)
+    return _pdep_u32(value, SEVEN_BIT_LANES);
+#else
+    return (value & 0x7F) |
+           ((value << 1) & 0x7F00) |
+           ((value << 2) & 0x7F0000) |
+           ((value << 3) & 0x7F000000);
+#endif
 }
 
-VariableByteInteger::VariableByteInteger(uint32_t value)
+/**
+ * @brief Gathers four 7 bit lanes back into a value
+ */
+static inline uint32_t extract(uint32_t packed)
 {
-    this->value = value;
+#if defined(__BMI2__)
+    return _pext_u32(packed, SEVEN_BIT_LANES);
+#else
+    return (packed & 0x7F) |
+           ((packed >> 1) & 0x3F80) |
+           ((packed >> 2) & 0x1FC000) |
+           ((packed >> 3) & 0xFE00000);
+#endif
 }
 
-size_t VariableByteInteger::size()
+size_t VariableByteInteger::encodedSize(uint32_t value)
 {
-    if (value < 128)
-    {
-        return 1;
-    }
-    if (value < 16384)
+    return 1 + (value > 0x7F) + (value > 0x3FFF) + (value > 0x1FFFFF);
+}
+
+size_t VariableByteInteger::encode(uint32_t value, uint8_t *output)
+{
+    size_t length = encodedSize(value);
+    uint32_t packed = deposit(value) | CONTINUATION_MASKS[length];
+
+    // Written byte by byte so the layout does not depend on the host byte order
+    output[0] = packed;
+    output[1] = packed >> 8;
+    output[2] = packed >> 16;
+    output[3] = packed >> 24;
+
+    return length;
+}
+
+size_t VariableByteInteger::decode(const uint8_t *input, size_t length, uint32_t &value)
+{
+    uint32_t packed = 0;
+    size_t available = (length < 4) ? length : 4;
+
+    for (size_t i = 0; i < available; i++)
     {
-        return 2;
+        packed |= (uint32_t)input[i] << (i * 8);
     }
-    if (value < 2097152)
+
+    // The first byte without a continuation bit ends the integer
+    uint32_t terminators = ~packed & CONTINUATION_BITS & LENGTH_MASKS[available];
+
+    if (terminators == 0)
     {
-        return 3;
+        return 0;
     }
 
-    return 4;
+    size_t consumed = (__builtin_ctz(terminators) >> 3) + 1;
+
+    value = extract(packed & LENGTH_MASKS[consumed]);
+
+    return consumed;
+}
+
+VariableByteInteger::VariableByteInteger()
+{
+}
+
+VariableByteInteger::VariableByteInteger(uint32_t value)
+{
+    this->value = value;
+}
+
+size_t VariableByteInteger::size()
+{
+    return encodedSize(value);
 };
 
 size_t VariableByteInteger::push(PacketBuffer &buffer)
 {
-    size_t length = size();
-    uint32_t value = this->value;
     uint8_t output[4];
-
-    for (size_t i = 0; i < length; i++)
-    {
-        if (i > 0)
-        {
-            output[i - 1] |= 0x80;
-        }
-        output[i] = 0x7F & value;
-        value >>= 7;
-    }
+    size_t length = encode(value, output);
 
     buffer.push(output, length);
     return length;
@@ -88,10 +149,8 @@ size_t VariableByteInteger::push(PacketBuffer &buffer)
 
 uint32_t VariableByteInteger::calculateValue(uint32_t input)
 {
-    return (((input & 0x800000) > 0) * (input & 0x7F000000)) >> 3 |
-           (((input & 0x8000) > 0) * (input & 0x7F0000)) >> 2 |
-           (((input & 0x80) > 0) * (input & 0x7F00)) >> 1 |
-           (input & 0x7F);
+    // Only the lanes up to the terminating byte are populated, continuation bits are dropped by extract
+    return extract(input);
 }
 
 bool VariableByteInteger::addByte(uint8_t byte)
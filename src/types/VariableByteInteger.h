@@ -32,8 +32,13 @@
 #ifndef VARIABLEBYTEINTEGER
 #define VARIABLEBYTEINTEGER
 
+#include <stddef.h>
+#include <stdint.h>
 #include "ClientInteractor.h"
 
+// Largest value a Variable Byte Integer can hold
+#define VARIABLE_BYTE_INTEGER_MAX 268435455
+
 namespace CppMqtt
 {
     /**
@@ -46,6 +51,31 @@ namespace CppMqtt
         static uint32_t calculateValue(uint32_t);
 
     public:
+        /**
+         * @brief Returns the amount of bytes required to encode a value
+         *
+         * @param value
+         * @return size_t 1 to 4
+         */
+        static size_t encodedSize(uint32_t value);
+        /**
+         * @brief Encodes a value into contiguous memory
+         *
+         * @param value The value to encode, must not exceed VARIABLE_BYTE_INTEGER_MAX
+         * @param output Memory with room for 4 bytes
+         * @return size_t The amount of bytes written
+         */
+        static size_t encode(uint32_t value, uint8_t *output);
+        /**
+         * @brief Decodes a value from contiguous memory
+         *
+         * @param input The encoded bytes
+         * @param length The amount of bytes available
+         * @param value The decoded value
+         * @return size_t The amount of bytes consumed, 0 if the input is incomplete or longer than 4 bytes
+         */
+        static size_t decode(const uint8_t *input, size_t length, uint32_t &value);
+
         VariableByteInteger();
         VariableByteInteger(uint32_t);
         uint32_t value = 0;
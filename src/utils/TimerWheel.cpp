@@ -0,0 +1,276 @@
+/*
+ * File: TimerWheel.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "TimerWheel.h"
+
+using namespace CppMqtt;
+
+Timer::~Timer()
+{
+    cancel();
+}
+
+void Timer::cancel()
+{
+    if (wheel != NULL)
+    {
+        wheel->unlink(this);
+    }
+}
+
+TimerWheel::~TimerWheel()
+{
+    for (auto &level : slots)
+    {
+        for (auto &slot : level)
+        {
+            while (slot != NULL)
+            {
+                unlink(slot);
+            }
+        }
+    }
+
+    while (expired != NULL)
+    {
+        unlink(expired);
+    }
+}
+
+void TimerWheel::insert(Timer *timer, uint64_t deadline)
+{
+    uint8_t level = 0;
+    uint8_t shift = 0;
+
+    // The lowest level where the deadline falls within a turn of the current position
+    while (level < TIMER_WHEEL_LEVELS - 1 && (deadline >> shift) - (now >> shift) >= TIMER_WHEEL_SLOTS)
+    {
+        level++;
+        shift += TIMER_WHEEL_SLOT_BITS;
+    }
+
+    uint64_t position = deadline >> shift;
+
+    // Beyond the last level, wait in its furthest slot and be placed again when it cascades
+    if (position - (now >> shift) >= TIMER_WHEEL_SLOTS)
+    {
+        position = (now >> shift) + TIMER_WHEEL_SLOTS - 1;
+    }
+
+    Timer **slot = &slots[level][position & TIMER_WHEEL_SLOT_MASK];
+
+    timer->slot = slot;
+    timer->wheel = this;
+    timer->previous = NULL;
+    timer->next = *slot;
+
+    if (*slot != NULL)
+    {
+        (*slot)->previous = timer;
+    }
+
+    *slot = timer;
+    count++;
+}
+
+void TimerWheel::unlink(Timer *timer)
+{
+    if (timer->slot == &expired)
+    {
+        expiredCount--;
+
+        if (timer == expiredTail)
+        {
+            expiredTail = timer->previous;
+        }
+    }
+
+    if (timer->previous != NULL)
+    {
+        timer->previous->next = timer->next;
+    }
+    else
+    {
+        *timer->slot = timer->next;
+    }
+
+    if (timer->next != NULL)
+    {
+        timer->next->previous = timer->previous;
+    }
+
+    timer->next = timer->previous = NULL;
+    timer->slot = NULL;
+    timer->wheel = NULL;
+    count--;
+}
+
+void TimerWheel::expire(Timer *timer)
+{
+    unlink(timer);
+
+    timer->slot = &expired;
+    timer->wheel = this;
+    timer->next = NULL;
+    timer->previous = expiredTail;
+
+    if (expiredTail != NULL)
+    {
+        expiredTail->next = timer;
+    }
+    else
+    {
+        expired = timer;
+    }
+
+    expiredTail = timer;
+    expiredCount++;
+    count++;
+}
+
+void TimerWheel::cascade(uint8_t level)
+{
+    Timer **slot = &slots[level][(now >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK];
+
+    while (*slot != NULL)
+    {
+        Timer *timer = *slot;
+        unlink(timer);
+        // Lands in the slot about to be processed if it is due on this tick
+        insert(timer, timer->deadline);
+    }
+}
+
+void TimerWheel::schedule(Timer &timer, uint32_t delay)
+{
+    if (timer.wheel != NULL)
+    {
+        timer.wheel->unlink(&timer);
+    }
+
+    timer.deadline = now + delay;
+    // The current slot has already been processed, so a timer due now expires on the next tick
+    insert(&timer, (delay > 0) ? timer.deadline : now + 1);
+}
+
+void TimerWheel::advance(uint32_t ticks)
+{
+    uint64_t target = now + ticks;
+
+    while (now < target)
+    {
+        // Nothing is left waiting in the slots, so time can be skipped
+        if (count == expiredCount)
+        {
+            now = target;
+            break;
+        }
+
+        now++;
+
+        // Each time a level completes a turn the next slot of the level above is spread over the levels below
+        for (uint8_t level = 1; level < TIMER_WHEEL_LEVELS; level++)
+        {
+            if ((now & (((uint64_t)1 << (level * TIMER_WHEEL_SLOT_BITS)) - 1)) != 0)
+            {
+                break;
+            }
+
+            cascade(level);
+        }
+
+        Timer **slot = &slots[0][now & TIMER_WHEEL_SLOT_MASK];
+
+        while (*slot != NULL)
+        {
+            expire(*slot);
+        }
+    }
+
+    while (expired != NULL)
+    {
+        Timer *timer = expired;
+        unlink(timer);
+
+        if (timer->callback)
+        {
+            // The callback may destroy its own timer, so it runs from a copy
+            TimerCallback callback = timer->callback;
+            callback();
+        }
+    }
+}
+
+int64_t TimerWheel::nextExpiry()
+{
+    if (expired != NULL)
+    {
+        return 0;
+    }
+
+    if (count == 0)
+    {
+        return -1;
+    }
+
+    uint64_t earliest = UINT64_MAX;
+
+    // Slots of a level are in deadline order from its current position, but a lower level can hold later
+    // deadlines than a higher one, so the first occupied slot of every level is checked
+    for (uint8_t level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        uint64_t position = now >> (level * TIMER_WHEEL_SLOT_BITS);
+
+        for (uint8_t offset = 0; offset < TIMER_WHEEL_SLOTS; offset++)
+        {
+            Timer *timer = slots[level][(position + offset) & TIMER_WHEEL_SLOT_MASK];
+
+            if (timer == NULL)
+            {
+                continue;
+            }
+
+            for (; timer != NULL; timer = timer->next)
+            {
+                if (timer->deadline < earliest)
+                {
+                    earliest = timer->deadline;
+                }
+            }
+
+            break;
+        }
+    }
+
+    // Timers due now wait in the next slot
+    return (earliest > now) ? (int64_t)(earliest - now) : 1;
+}
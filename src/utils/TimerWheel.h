@@ -0,0 +1,164 @@
+/*
+ * File: TimerWheel.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef SRC_UTILS_TIMERWHEEL
+#define SRC_UTILS_TIMERWHEEL
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+
+namespace CppMqtt
+{
+    class TimerWheel;
+
+    typedef std::function<void()> TimerCallback;
+
+    /**
+     * @brief A deadline held by a TimerWheel
+     * Timers are linked into the wheel directly, so scheduling and cancelling never allocate.
+     * A timer is cancelled when destroyed.
+     */
+    class Timer
+    {
+    private:
+        friend class TimerWheel;
+
+        Timer *next = NULL;
+        Timer *previous = NULL;
+        Timer **slot = NULL;
+        TimerWheel *wheel = NULL;
+        uint64_t deadline = 0;
+        TimerCallback callback;
+
+    public:
+        Timer(){};
+        Timer(TimerCallback callback) : callback(callback){};
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+        ~Timer();
+
+        void setCallback(TimerCallback value) { callback = value; };
+        /**
+         * @brief Returns whether the timer is waiting in a wheel
+         *
+         * @return true
+         * @return false
+         */
+        bool scheduled() { return wheel != NULL; };
+        /**
+         * @brief Returns the tick the timer expires on
+         *
+         * @return uint64_t
+         */
+        uint64_t getDeadline() { return deadline; };
+        /**
+         * @brief Removes the timer from its wheel, does nothing if it is not scheduled
+         */
+        void cancel();
+    };
+
+    /**
+     * @brief A hierarchical timing wheel
+     * Four levels of 64 slots cover about 4.6 hours at millisecond ticks, later deadlines wait in the last level
+     * and are placed again as it turns. Scheduling, cancelling and each tick are constant time regardless of the
+     * amount of timers, so one wheel can serve any amount of clients.
+     */
+    class TimerWheel
+    {
+    private:
+        friend class Timer;
+
+        Timer *slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS] = {};
+        // Timers that have expired during an advance, in deadline order, waiting for their callbacks
+        Timer *expired = NULL;
+        Timer *expiredTail = NULL;
+        uint64_t now = 0;
+        size_t count = 0;
+        size_t expiredCount = 0;
+
+        /**
+         * @brief Links a timer into the slot for a tick, which must not be before the current tick
+         */
+        void insert(Timer *timer, uint64_t deadline);
+        void unlink(Timer *timer);
+        void expire(Timer *timer);
+        void cascade(uint8_t level);
+
+    public:
+        TimerWheel(){};
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+        ~TimerWheel();
+
+        /**
+         * @brief Schedules a timer, rescheduling it if it is already waiting
+         *
+         * @param timer
+         * @param delay The amount of ticks until the timer expires, 0 expires on the next tick
+         */
+        void schedule(Timer &timer, uint32_t delay);
+        /**
+         * @brief Moves time forward, expiring every timer whose deadline is reached
+         * Callbacks run in deadline order once time has been moved, so timers they schedule count from the new time.
+         * Callbacks may schedule or cancel any timer, including the one expiring.
+         *
+         * @param ticks
+         */
+        void advance(uint32_t ticks);
+        /**
+         * @brief Returns the amount of ticks until the next timer expires
+         *
+         * @return int64_t -1 if no timers are scheduled
+         */
+        int64_t nextExpiry();
+        /**
+         * @brief Returns the current tick
+         *
+         * @return uint64_t
+         */
+        uint64_t getTime() { return now; };
+        /**
+         * @brief Returns the amount of scheduled timers
+         *
+         * @return size_t
+         */
+        size_t size() { return count; };
+    };
+}
+
+#endif /* SRC_UTILS_TIMERWHEEL */
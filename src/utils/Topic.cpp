@@ -0,0 +1,184 @@
+/*
+ * File: Topic.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include <string.h>
+#include "utils/Topic.h"
+#include "utils/Utf8.h"
+
+#define SHARED_PREFIX "$share/"
+#define SHARED_PREFIX_LENGTH 7
+
+using namespace CppMqtt;
+
+/**
+ * @brief Checks the wildcards of a filter in a single pass
+ */
+static bool hasValidWildcards(const char *filter, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        char character = filter[i];
+
+        if (character == '+')
+        {
+            // Must occupy the whole level
+            if ((i > 0 && filter[i - 1] != '/') || (i + 1 < length && filter[i + 1] != '/'))
+            {
+                return false;
+            }
+        }
+        else if (character == '#')
+        {
+            // Must occupy the whole of the last level
+            if ((i > 0 && filter[i - 1] != '/') || i + 1 != length)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CppMqtt::isValidTopicName(const char *topic, size_t length)
+{
+    if (length == 0)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (topic[i] == '+' || topic[i] == '#')
+        {
+            return false;
+        }
+    }
+
+    return isValidUtf8((const uint8_t *)topic, length, false);
+}
+
+bool CppMqtt::isValidTopicFilter(const char *filter, size_t length)
+{
+    if (length == 0)
+    {
+        return false;
+    }
+
+    if (length >= SHARED_PREFIX_LENGTH && memcmp(filter, SHARED_PREFIX, SHARED_PREFIX_LENGTH) == 0)
+    {
+        const char *shareName = filter + SHARED_PREFIX_LENGTH;
+        const char *separator = (const char *)memchr(shareName, '/', length - SHARED_PREFIX_LENGTH);
+
+        if (separator == NULL || separator == shareName)
+        {
+            return false;
+        }
+
+        for (const char *character = shareName; character < separator; character++)
+        {
+            if (*character == '+' || *character == '#')
+            {
+                return false;
+            }
+        }
+
+        // The remainder is an ordinary filter
+        size_t offset = (separator + 1) - filter;
+
+        if (offset == length || !hasValidWildcards(separator + 1, length - offset))
+        {
+            return false;
+        }
+    }
+    else if (!hasValidWildcards(filter, length))
+    {
+        return false;
+    }
+
+    return isValidUtf8((const uint8_t *)filter, length, false);
+}
+
+bool CppMqtt::topicMatchesFilter(const char *filter, size_t filterLength, const char *topic, size_t topicLength)
+{
+    if (filterLength >= SHARED_PREFIX_LENGTH && memcmp(filter, SHARED_PREFIX, SHARED_PREFIX_LENGTH) == 0)
+    {
+        const char *separator = (const char *)memchr(filter + SHARED_PREFIX_LENGTH, '/', filterLength - SHARED_PREFIX_LENGTH);
+
+        if (separator == NULL)
+        {
+            return false;
+        }
+
+        filterLength -= (separator + 1) - filter;
+        filter = separator + 1;
+    }
+
+    // Wildcards at the first level do not match topics reserved by the server
+    if (topicLength > 0 && topic[0] == '$' && filterLength > 0 && (filter[0] == '+' || filter[0] == '#'))
+    {
+        return false;
+    }
+
+    size_t f = 0;
+    size_t t = 0;
+
+    while (f < filterLength)
+    {
+        if (filter[f] == '#')
+        {
+            // Matches the parent level and any number of child levels
+            return true;
+        }
+
+        if (filter[f] == '+')
+        {
+            while (t < topicLength && topic[t] != '/')
+            {
+                t++;
+            }
+            f++;
+        }
+        else
+        {
+            if (t == topicLength || filter[f] != topic[t])
+            {
+                // "sport/#" also matches "sport"
+                return t == topicLength && f + 1 < filterLength && filter[f] == '/' && filter[f + 1] == '#';
+            }
+            f++;
+            t++;
+        }
+    }
+
+    return t == topicLength;
+}
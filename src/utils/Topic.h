@@ -0,0 +1,81 @@
+/*
+ * File: Topic.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef SRC_UTILS_TOPIC
+#define SRC_UTILS_TOPIC
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace CppMqtt
+{
+    /**
+     * @brief Checks a topic name can be published to
+     * Topic names must be at least one character, must not contain the wildcards '+' or '#'
+     * and must be well formed UTF-8 without null characters. Empty levels are permitted.
+     *
+     * @param topic The topic name
+     * @param length The length of the topic name
+     * @return true If the topic name is valid
+     * @return false If the topic name is not valid
+     */
+    bool isValidTopicName(const char *topic, size_t length);
+
+    /**
+     * @brief Checks a topic filter can be subscribed to
+     * Topic filters follow the topic name rules, except that '+' may occupy an entire level and
+     * '#' may occupy the last level. Shared subscriptions of the form $share/{ShareName}/{filter}
+     * require a non empty share name without wildcards or separators.
+     *
+     * @param filter The topic filter
+     * @param length The length of the topic filter
+     * @return true If the topic filter is valid
+     * @return false If the topic filter is not valid
+     */
+    bool isValidTopicFilter(const char *filter, size_t length);
+
+    /**
+     * @brief Checks whether a topic name is matched by a topic filter
+     * Both are expected to be valid. Wildcards do not match topic names starting with '$'
+     * at the first level, and shared subscriptions match on the filter after the share name.
+     *
+     * @param filter The topic filter
+     * @param filterLength The length of the topic filter
+     * @param topic The topic name
+     * @param topicLength The length of the topic name
+     * @return true If the filter matches the topic name
+     * @return false If the filter does not match the topic name
+     */
+    bool topicMatchesFilter(const char *filter, size_t filterLength, const char *topic, size_t topicLength);
+}
+
+#endif /* SRC_UTILS_TOPIC */
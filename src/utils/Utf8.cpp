@@ -0,0 +1,189 @@
+/*
+ * File: Utf8.cpp
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include <string.h>
+#include "utils/Utf8.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UTF8_BLOCK_SIZE 32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define UTF8_BLOCK_SIZE 16
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define UTF8_BLOCK_SIZE 16
+#else
+#define UTF8_BLOCK_SIZE 8
+#endif
+
+#define HIGH_BITS 0x8080808080808080ULL
+#define LOW_BITS 0x0101010101010101ULL
+
+using namespace CppMqtt;
+
+/**
+ * @brief Returns whether a block holds only ASCII, and no null characters unless allowed
+ */
+static inline bool isAsciiBlock(const uint8_t *data, bool allowNull)
+{
+#if defined(__AVX2__)
+    __m256i block = _mm256_loadu_si256((const __m256i *)data);
+    if (!allowNull)
+    {
+        // Null bytes compare to 0xFF, setting the high bit checked below
+        block = _mm256_or_si256(block, _mm256_cmpeq_epi8(block, _mm256_setzero_si256()));
+    }
+    return _mm256_movemask_epi8(block) == 0;
+#elif defined(__SSE2__)
+    __m128i block = _mm_loadu_si128((const __m128i *)data);
+    if (!allowNull)
+    {
+        block = _mm_or_si128(block, _mm_cmpeq_epi8(block, _mm_setzero_si128()));
+    }
+    return _mm_movemask_epi8(block) == 0;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16_t block = vld1q_u8(data);
+    if (!allowNull)
+    {
+        block = vorrq_u8(block, vceqq_u8(block, vdupq_n_u8(0)));
+    }
+    return vmaxvq_u8(block) < 0x80;
+#else
+    uint64_t block;
+    memcpy(&block, data, sizeof(block));
+    uint64_t flagged = block & HIGH_BITS;
+    if (!allowNull)
+    {
+        flagged |= (block - LOW_BITS) & ~block & HIGH_BITS;
+    }
+    return flagged == 0;
+#endif
+}
+
+/**
+ * @brief Validates a single character
+ *
+ * @return size_t The length of the character, 0 if it is not valid
+ */
+static inline size_t validateCharacter(const uint8_t *data, size_t remaining, bool allowNull)
+{
+    uint8_t lead = data[0];
+
+    if (lead < 0x80)
+    {
+        return (lead != 0 || allowNull) ? 1 : 0;
+    }
+
+    size_t length;
+    // Range of the second byte, which excludes overlong encodings, surrogates and values past U+10FFFF
+    uint8_t lower = 0x80;
+    uint8_t upper = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        length = 2;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        length = 3;
+        if (lead == 0xE0)
+        {
+            lower = 0xA0;
+        }
+        else if (lead == 0xED)
+        {
+            upper = 0x9F;
+        }
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        length = 4;
+        if (lead == 0xF0)
+        {
+            lower = 0x90;
+        }
+        else if (lead == 0xF4)
+        {
+            upper = 0x8F;
+        }
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (remaining < length || data[1] < lower || data[1] > upper)
+    {
+        return 0;
+    }
+
+    for (size_t i = 2; i < length; i++)
+    {
+        if ((data[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+    }
+
+    return length;
+}
+
+bool CppMqtt::isValidUtf8(const uint8_t *data, size_t length, bool allowNull)
+{
+    size_t position = 0;
+
+    while (position < length)
+    {
+        while (length - position >= UTF8_BLOCK_SIZE && isAsciiBlock(data + position, allowNull))
+        {
+            position += UTF8_BLOCK_SIZE;
+        }
+
+        // Check character by character until the next block boundary before returning to the fast path
+        size_t end = (length - position > UTF8_BLOCK_SIZE) ? position + UTF8_BLOCK_SIZE : length;
+
+        while (position < end)
+        {
+            size_t characterLength = validateCharacter(data + position, length - position, allowNull);
+
+            if (characterLength == 0)
+            {
+                return false;
+            }
+
+            position += characterLength;
+        }
+    }
+
+    return true;
+}
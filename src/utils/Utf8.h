@@ -0,0 +1,55 @@
+/*
+ * File: Utf8.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef SRC_UTILS_UTF8
+#define SRC_UTILS_UTF8
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace CppMqtt
+{
+    /**
+     * @brief Checks that data is well formed UTF-8
+     * Overlong encodings, surrogates and code points above U+10FFFF are rejected.
+     * Runs of ASCII are checked a block at a time using SSE2, AVX2 or NEON when available.
+     *
+     * @param data The data to check
+     * @param length The length of the data
+     * @param allowNull Whether U+0000 is permitted, MQTT 5 forbids it in UTF-8 Encoded Strings
+     * @return true If the data is valid
+     * @return false If the data is not valid
+     */
+    bool isValidUtf8(const uint8_t *data, size_t length, bool allowNull = true);
+}
+
+#endif /* SRC_UTILS_UTF8 */
@@ -0,0 +1,236 @@
+/*
+ * File: AllocatorTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+#include <new>
+
+#include "Allocator.h"
+#include "PacketBuffer.h"
+#include "types/Payload.h"
+#include "types/EncodedString.h"
+#include "packets/Publish.h"
+#include "properties/ByteProperty.h"
+#include "MqttProperties.h"
+#include "mocks/MockClient.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+/**
+ * @brief Allocator forwarding to malloc while counting outstanding allocations
+ */
+class CountingAllocator : public MallocAllocator
+{
+public:
+    int allocations = 0;
+    int outstanding = 0;
+    size_t bytes = 0;
+
+    void *allocate(size_t size) override
+    {
+        allocations++;
+        outstanding++;
+        bytes += size;
+        return MallocAllocator::allocate(size);
+    }
+
+    void deallocate(void *pointer, size_t size) override
+    {
+        outstanding--;
+        bytes -= size;
+        MallocAllocator::deallocate(pointer, size);
+    }
+};
+
+/**
+ * @brief Installs an Allocator for the lifetime of the scope
+ */
+class ScopedAllocator
+{
+private:
+    Allocator *previous;
+
+public:
+    ScopedAllocator(Allocator *allocator) { previous = setDefaultAllocator(allocator); }
+    ~ScopedAllocator() { setDefaultAllocator(previous); }
+};
+
+TEST(AllocatorTest, DefaultAllocator)
+{
+    Allocator *allocator = getDefaultAllocator();
+    ASSERT_NE(allocator, nullptr);
+
+    CountingAllocator counting;
+    ASSERT_EQ(setDefaultAllocator(&counting), allocator);
+    ASSERT_EQ(getDefaultAllocator(), &counting);
+    ASSERT_EQ(setDefaultAllocator(NULL), &counting);
+    ASSERT_EQ(getDefaultAllocator(), allocator);
+}
+
+TEST(AllocatorTest, FixedPool)
+{
+    FixedPoolAllocator pool(24, 2);
+
+    void *first = pool.allocate(24);
+    void *second = pool.allocate(8);
+
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(first, second);
+    ASSERT_TRUE(pool.owns(first));
+    ASSERT_TRUE(pool.owns(second));
+    ASSERT_EQ((uintptr_t)first % alignof(max_align_t), 0);
+
+    // Exhausted
+    ASSERT_EQ(pool.allocate(8), nullptr);
+
+    pool.deallocate(first, 24);
+    ASSERT_EQ(pool.allocate(64), nullptr);
+    ASSERT_EQ(pool.allocate(8), first);
+}
+
+TEST(AllocatorTest, RoutesAllocations)
+{
+    CountingAllocator counting;
+
+    {
+        ScopedAllocator scope(&counting);
+
+        PacketBuffer buffer(16);
+        ASSERT_EQ(counting.outstanding, 1);
+
+        Payload payload(64);
+        Payload copy(payload);
+        ASSERT_EQ(counting.outstanding, 3);
+
+        Payload moved(std::move(copy));
+        ASSERT_EQ(counting.outstanding, 3);
+
+        // Short strings stay inline
+        EncodedString shortString("short", 5);
+        ASSERT_EQ(counting.outstanding, 3);
+
+        const char text[] = "a topic name that is long enough to be moved out of the inline buffer of a string";
+        EncodedString longString(text, sizeof(text) - 1);
+        ASSERT_EQ(counting.outstanding, 4);
+
+        Property *property = new ByteProperty(PAYLOAD_FORMAT_INDICATOR, 1);
+        ASSERT_EQ(counting.outstanding, 5);
+        delete property;
+
+        Packet *packet = new Publish();
+        ASSERT_GT(counting.outstanding, 4);
+        delete packet;
+        ASSERT_EQ(counting.outstanding, 4);
+    }
+
+    ASSERT_GT(counting.allocations, 0);
+    ASSERT_EQ(counting.outstanding, 0);
+    ASSERT_EQ(counting.bytes, 0);
+}
+
+TEST(AllocatorTest, PropertyArena)
+{
+    CountingAllocator counting;
+
+    {
+        ScopedAllocator scope(&counting);
+
+        PropertyArena arena;
+        ASSERT_NE(arena.allocate(16), nullptr);
+        ASSERT_EQ(counting.outstanding, 1);
+
+        // Larger than the first block, a second block is started
+        ASSERT_NE(arena.allocate(PROPERTY_ARENA_SIZE), nullptr);
+        ASSERT_EQ(counting.outstanding, 2);
+
+        arena.rewind();
+        ASSERT_EQ(counting.outstanding, 1);
+    }
+
+    ASSERT_EQ(counting.outstanding, 0);
+    ASSERT_EQ(counting.bytes, 0);
+}
+
+TEST(AllocatorTest, Exhausted)
+{
+    FixedPoolAllocator pool(16, 1);
+    ScopedAllocator scope(&pool);
+
+    ASSERT_THROW(new ByteProperty(PAYLOAD_FORMAT_INDICATOR, 1), std::bad_alloc);
+}
+
+TEST(AllocatorTest, ExhaustedPropertyRead)
+{
+    FixedPoolAllocator pool(16, 1);
+    ScopedAllocator scope(&pool);
+
+    MockClient client;
+    Properties properties;
+    uint32_t read = 0;
+
+    uint8_t data[] = {
+        0x04,       // Properties Length
+        0x01, 0x01, // Payload Format Indicator
+        0x24, 0x01, // Maximum QoS
+        0xE0        // Start of the next packet
+    };
+
+    client.pushToReadBuffer(data, sizeof(data));
+
+    // The arena cannot get a block, the property block is skipped rather than decoded
+    ASSERT_FALSE(properties.readFromClient((Client *)&client, read));
+    ASSERT_TRUE(properties.isMalformed());
+    ASSERT_EQ(properties.length(), 0);
+    ASSERT_EQ(read, 5);
+    ASSERT_EQ(client.available(), 1);
+
+    properties.clear();
+    ASSERT_FALSE(properties.isMalformed());
+}
+
+TEST(AllocatorTest, OutlivesDefault)
+{
+    CountingAllocator counting;
+    Payload *payload;
+
+    {
+        ScopedAllocator scope(&counting);
+        payload = new Payload(32);
+    }
+
+    // Memory is returned to the Allocator it came from, not the current default
+    delete payload;
+    ASSERT_EQ(counting.outstanding, 0);
+}
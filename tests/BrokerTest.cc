@@ -0,0 +1,282 @@
+/*
+ * File: BrokerTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+#include <functional>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <poll.h>
+
+#include "Broker.h"
+#include "SocketClient.h"
+#include "MqttClient.h"
+#include "utils/MqttTestHandler.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+#define SYNC_ATTEMPTS 1000
+
+/**
+ * @brief An MqttClient connected to the broker over a socket pair
+ */
+class BrokerConnection
+{
+private:
+    int sockets[2];
+
+public:
+    SocketClient *client;
+    SocketClient *server;
+    MqttViewTestHandler handler;
+    MqttClient *mqttClient;
+
+    BrokerConnection()
+    {
+        EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+        client = new SocketClient(sockets[0]);
+        server = new SocketClient(sockets[1]);
+        mqttClient = new MqttClient(client);
+        mqttClient->setHandler((MqttClientHandlerV2 *)&handler);
+    }
+
+    ~BrokerConnection()
+    {
+        delete mqttClient;
+        delete client;
+        delete server;
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+    }
+};
+
+class BrokerTest : public ::testing::Test
+{
+protected:
+    Broker broker;
+    BrokerConnection publisher;
+    BrokerConnection subscriber;
+
+    /**
+     * @brief Syncs the broker and both clients until the condition is met
+     */
+    bool syncUntil(function<bool()> condition)
+    {
+        for (int i = 0; i < SYNC_ATTEMPTS && !condition(); i++)
+        {
+            publisher.mqttClient->sync();
+            subscriber.mqttClient->sync();
+            broker.sync();
+        }
+
+        return condition();
+    }
+
+    void connect(BrokerConnection &connection)
+    {
+        broker.attach(connection.server);
+        connection.mqttClient->connect("localhost", 1883, 0);
+
+        ASSERT_TRUE(syncUntil([&]()
+                              { return connection.handler.connectionResult == 0; }));
+    }
+
+    void subscribe(BrokerConnection &connection, const char *filter, QoS qos, uint8_t expected)
+    {
+        SubscribePayload payload;
+        payload.setTopic(filter, strlen(filter));
+        payload.setMaximumQos(qos);
+
+        int token = connection.mqttClient->subscribe(payload);
+
+        ASSERT_NE(token, -1);
+        ASSERT_TRUE(syncUntil([&]()
+                              { return connection.handler.subscribeResult.count(token) > 0; }));
+        ASSERT_EQ(connection.handler.subscribeResult[token], vector<uint8_t>({expected}));
+    }
+
+    void SetUp() override
+    {
+        connect(publisher);
+        connect(subscriber);
+        ASSERT_EQ(broker.sessionCount(), 2);
+    }
+};
+
+TEST_F(BrokerTest, RoutesEachQos)
+{
+    subscribe(subscriber, "sport/+/player1", QoS::TWO, QoS::TWO);
+
+    EncodedString topic("sport/tennis/player1", 20);
+    uint8_t data[] = {1, 2, 3};
+
+    for (QoS qos : {QoS::ZERO, QoS::ONE, QoS::TWO})
+    {
+        Payload payload(data, sizeof(data));
+        Token token = publisher.mqttClient->publish(topic, payload, qos);
+
+        ASSERT_TRUE(syncUntil([&]()
+                              { return subscriber.handler.topicQueue.size() == 1 && publisher.mqttClient->isDelivered(token); }))
+            << "QoS " << qos._to_integral();
+
+        ASSERT_EQ(subscriber.handler.topicQueue.front(), "sport/tennis/player1");
+        ASSERT_EQ(subscriber.handler.payloadQueue.front(), vector<uint8_t>({1, 2, 3}));
+        ASSERT_EQ(get<0>(subscriber.handler.metadataQueue.front()), qos._to_integral());
+        ASSERT_FALSE(get<1>(subscriber.handler.metadataQueue.front()));
+
+        subscriber.handler.topicQueue.pop();
+        subscriber.handler.payloadQueue.pop();
+        subscriber.handler.metadataQueue.pop();
+    }
+
+    // Topics that do not match the filter are not routed
+    EncodedString other("sport/tennis/player2", 20);
+    publisher.mqttClient->publish(other, Payload(data, sizeof(data)), QoS::ZERO);
+
+    syncUntil([]()
+              { return false; });
+
+    ASSERT_TRUE(subscriber.handler.topicQueue.empty());
+    ASSERT_EQ(broker.publishesReceived(), 4);
+}
+
+TEST_F(BrokerTest, DowngradesToGrantedQos)
+{
+    subscribe(subscriber, "sport/#", QoS::ZERO, QoS::ZERO);
+
+    EncodedString topic("sport", 5);
+    uint8_t data[] = {4};
+    Token token = publisher.mqttClient->publish(topic, Payload(data, sizeof(data)), QoS::TWO);
+
+    ASSERT_TRUE(syncUntil([&]()
+                          { return subscriber.handler.topicQueue.size() == 1 && publisher.mqttClient->isDelivered(token); }));
+    ASSERT_EQ(get<0>(subscriber.handler.metadataQueue.front()), QoS::ZERO);
+}
+
+TEST_F(BrokerTest, RetainedMessages)
+{
+    EncodedString topic("status/door", 11);
+    uint8_t data[] = {'o', 'p', 'e', 'n'};
+    Token token = publisher.mqttClient->publish(topic, Payload(data, sizeof(data)), QoS::ONE, true);
+
+    ASSERT_TRUE(syncUntil([&]()
+                          { return publisher.mqttClient->isDelivered(token); }));
+    ASSERT_EQ(broker.retainedCount(), 1);
+
+    subscribe(subscriber, "status/#", QoS::ONE, QoS::ONE);
+
+    ASSERT_TRUE(syncUntil([&]()
+                          { return subscriber.handler.topicQueue.size() == 1; }));
+    ASSERT_EQ(subscriber.handler.topicQueue.front(), "status/door");
+    ASSERT_EQ(subscriber.handler.payloadQueue.front(), vector<uint8_t>({'o', 'p', 'e', 'n'}));
+    ASSERT_EQ(get<0>(subscriber.handler.metadataQueue.front()), QoS::ONE);
+    ASSERT_TRUE(get<1>(subscriber.handler.metadataQueue.front()));
+
+    // An empty retained publish clears the message
+    token = publisher.mqttClient->publish(topic, Payload(), QoS::ONE, true);
+
+    ASSERT_TRUE(syncUntil([&]()
+                          { return publisher.mqttClient->isDelivered(token); }));
+    ASSERT_EQ(broker.retainedCount(), 0);
+}
+
+TEST_F(BrokerTest, Unsubscribe)
+{
+    subscribe(subscriber, "a/b", QoS::ONE, QoS::ONE);
+    subscribe(subscriber, "$share/group/a/b", QoS::ONE, ReasonCode::SHARED_SUBSCRIPTIONS_NOT_SUPPORTED);
+
+    UnsubscribePayload payload;
+    payload.setTopic("a/b", 3);
+
+    int token = subscriber.mqttClient->unsubscribe(payload);
+
+    ASSERT_TRUE(syncUntil([&]()
+                          { return subscriber.handler.unsubscribeResult.count(token) > 0; }));
+    ASSERT_EQ(subscriber.handler.unsubscribeResult[token], vector<uint8_t>({ReasonCode::SUCCESS}));
+
+    token = subscriber.mqttClient->unsubscribe(payload);
+
+    ASSERT_TRUE(syncUntil([&]()
+                          { return subscriber.handler.unsubscribeResult.count(token) > 0; }));
+    ASSERT_EQ(subscriber.handler.unsubscribeResult[token], vector<uint8_t>({ReasonCode::NO_SUBSCRIPTION_FOUND}));
+
+    EncodedString topic("a/b", 3);
+    uint8_t data[] = {1};
+    Token published = publisher.mqttClient->publish(topic, Payload(data, sizeof(data)), QoS::ONE);
+
+    ASSERT_TRUE(syncUntil([&]()
+                          { return publisher.mqttClient->isDelivered(published); }));
+    ASSERT_TRUE(subscriber.handler.topicQueue.empty());
+}
+
+TEST_F(BrokerTest, Disconnect)
+{
+    subscriber.mqttClient->disconnect(ReasonCode::NORMAL_DISCONNECTION);
+
+    ASSERT_TRUE(syncUntil([&]()
+                          { return broker.sessionCount() == 1; }));
+}
+
+TEST_F(BrokerTest, WaitsOnDescriptor)
+{
+    subscribe(subscriber, "sport/#", QoS::ZERO, QoS::ZERO);
+
+    struct pollfd descriptor = {subscriber.mqttClient->getFileDescriptor(), POLLIN, 0};
+
+    ASSERT_EQ(descriptor.fd, subscriber.client->getFileDescriptor());
+    ASSERT_TRUE(subscriber.mqttClient->wantsRead());
+    ASSERT_FALSE(subscriber.mqttClient->wantsWrite());
+
+    // Idle, so the subscriber can sleep until its descriptor is readable
+    ASSERT_NE(subscriber.mqttClient->getTimeout(), 0);
+    ASSERT_EQ(::poll(&descriptor, 1, 0), 0);
+
+    EncodedString topic("sport", 5);
+    uint8_t data[] = {5};
+    publisher.mqttClient->publish(topic, Payload(data, sizeof(data)), QoS::ZERO);
+
+    for (int i = 0; i < SYNC_ATTEMPTS && ::poll(&descriptor, 1, 0) == 0; i++)
+    {
+        publisher.mqttClient->sync();
+        broker.sync();
+    }
+
+    ASSERT_TRUE(descriptor.revents & POLLIN);
+
+    subscriber.mqttClient->sync();
+
+    ASSERT_EQ(subscriber.handler.topicQueue.size(), 1);
+    ASSERT_NE(subscriber.mqttClient->getTimeout(), 0);
+}
@@ -0,0 +1,100 @@
+/*
+ * File: LatencyHistogramTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+
+#include "LatencyHistogram.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+TEST(LatencyHistogramTest, Buckets)
+{
+    // Small values are exact
+    for (uint32_t value = 0; value < LATENCY_HISTOGRAM_SUB_BUCKETS; value++)
+    {
+        ASSERT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(value)), value);
+    }
+
+    for (uint32_t value : {8u, 9u, 17u, 100u, 1000u, 123456u, 0x80000000u, UINT32_MAX})
+    {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        uint32_t upper = LatencyHistogram::bucketUpperBound(index);
+
+        ASSERT_LT(index, LATENCY_HISTOGRAM_BUCKETS);
+        ASSERT_GE(upper, value);
+        // Within the relative error of the precision
+        ASSERT_LE(upper - value, value >> LATENCY_HISTOGRAM_PRECISION) << value;
+        // Buckets are contiguous
+        ASSERT_EQ(LatencyHistogram::bucketIndex(upper), index);
+        if (upper != UINT32_MAX)
+        {
+            ASSERT_EQ(LatencyHistogram::bucketIndex(upper + 1), index + 1);
+        }
+    }
+}
+
+TEST(LatencyHistogramTest, Percentiles)
+{
+    LatencyHistogram histogram;
+
+    ASSERT_EQ(histogram.getCount(), 0);
+    ASSERT_EQ(histogram.getPercentile(50), 0);
+    ASSERT_EQ(histogram.getMinimum(), 0);
+
+    for (uint32_t value = 1; value <= 1000; value++)
+    {
+        histogram.record(value);
+    }
+
+    ASSERT_EQ(histogram.getCount(), 1000);
+    ASSERT_EQ(histogram.getMinimum(), 1);
+    ASSERT_EQ(histogram.getMaximum(), 1000);
+
+    uint32_t median = histogram.getPercentile(50);
+    ASSERT_GE(median, 500);
+    ASSERT_LE(median, 500 + (500 >> LATENCY_HISTOGRAM_PRECISION));
+
+    uint32_t tail = histogram.getPercentile(99);
+    ASSERT_GE(tail, 990);
+    ASSERT_LE(tail, 1000);
+
+    ASSERT_EQ(histogram.getPercentile(100), 1000);
+
+    histogram.reset();
+
+    ASSERT_EQ(histogram.getCount(), 0);
+    ASSERT_EQ(histogram.getMaximum(), 0);
+}
@@ -38,6 +38,7 @@
 #include "MqttProperties.h"
 #include "MqttClient.h"
 #include "mocks/MockMqttClient.h"
+#include "utils/MqttTestHandler.h"
 #include "packets/ConnectAcknowledge.h"
 
 using namespace std;
@@ -410,3 +411,873 @@ TEST(MqttClientTests, TestKeepAlivePeriod)
         ASSERT_EQ(writeBuffer[i], (char)disconnectPacket[i]) << "at position " << i;
     }
 }
+
+TEST(MqttClientTests, AutoReconnectBackoff)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MockMqttClient mqttClient(clientPtr);
+
+    mqttClient.setAutoReconnect(100);
+    mqttClient.setMaximumReconnectDelay(400);
+
+    setupConnected(client, mqttClient);
+
+    client.clearWriteBuffer();
+    client.setIsConnected(false);
+
+    mqttClient.sync();
+
+    ASSERT_FALSE(mqttClient.connected());
+
+    // Each failed attempt doubles the delay, half of which is jittered
+    uint32_t ceilings[] = {100, 200, 400, 400};
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        uint32_t minimum = ceilings[i] - ceilings[i] / 2;
+
+        mqttClient.setElapsedTime(minimum - 1);
+        mqttClient.sync();
+        ASSERT_EQ(mqttClient.getReconnectStatistics().attempts, i) << "attempt " << i;
+
+        mqttClient.setElapsedTime(ceilings[i] / 2 + 1);
+        mqttClient.sync();
+        ASSERT_EQ(mqttClient.getReconnectStatistics().attempts, i + 1) << "attempt " << i;
+    }
+
+    client.setIsConnected(true);
+    mqttClient.sync();
+
+    ASSERT_NE(client.getWriteBuffer(), nullptr);
+    ASSERT_EQ(client.getWriteBuffer()[0], 0x10);
+
+    const unsigned char connack[] = {
+        0x20, 0x03, // Variable Length
+        0x00,       // Flags
+        0x00,       // Success
+        0x00        // No properties
+    };
+
+    client.pushToReadBuffer((void *)connack, 5);
+
+    mqttClient.setElapsedTime(10);
+    mqttClient.sync();
+
+    ASSERT_TRUE(mqttClient.connected());
+
+    ReconnectStatistics statistics = mqttClient.getReconnectStatistics();
+
+    ASSERT_EQ(statistics.reconnects, 1);
+    ASSERT_GT(statistics.lastLatency, 0);
+    ASSERT_EQ(statistics.lastLatency, statistics.maximumLatency);
+}
+
+TEST(MqttClientTests, ReceiveQos2)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    MqttTestHandler handler;
+
+    MqttClient mqttClient(clientPtr);
+    mqttClient.setHandler((MqttClientHandler *)&handler);
+
+    setupConnected(client, mqttClient);
+
+    const unsigned char publish[] = {
+        0x34,                                  // Publish ID with QoS 2
+        0x0F,                                  // Remaining Length
+        0x00, 0x08,                            // Length of topic (Big Endian Ordering)
+        'm', 'y', '/', 't', 'o', 'p', 'i', 'c', // Topic
+        0x01, 0x01,                            // Packet Identifier
+        0x00,                                  // No properties
+        'h', 'i'                               // Payload
+    };
+
+    client.pushToReadBuffer((void *)publish, sizeof(publish));
+
+    mqttClient.sync();
+
+    ASSERT_TRUE(handler.topicQueue.empty());
+
+    const unsigned char pubrel[] = {
+        0x62,       // ID
+        0x02,       // Variable Length
+        0x01, 0x01, // Packet Identifier
+    };
+
+    client.pushToReadBuffer((void *)pubrel, sizeof(pubrel));
+
+    mqttClient.sync();
+
+    ASSERT_EQ(handler.topicQueue.size(), 1);
+    ASSERT_EQ(handler.payloadQueue.front().size(), 2);
+    ASSERT_EQ(handler.payloadQueue.front()[0], 'h');
+    ASSERT_EQ(handler.topicQueue.front()[0], 'm');
+}
+
+TEST(MqttClientTests, InvalidUtf8)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    MqttTestHandler handler;
+
+    MqttClient mqttClient(clientPtr);
+    mqttClient.setHandler((MqttClientHandler *)&handler);
+
+    setupConnected(client, mqttClient);
+
+    EncodedString topic("bad\xC3", 4);
+    Payload payload;
+
+    ASSERT_EQ(mqttClient.publish(topic, payload, QoS::ZERO), (uint16_t)-1);
+    ASSERT_EQ(client.getWriteBuffer(), nullptr);
+
+    const unsigned char publish[] = {
+        0x30,                  // Publish ID with QoS 0
+        0x08,                  // Remaining Length
+        0x00, 0x01,            // Length of topic (Big Endian Ordering)
+        't',                   // Topic
+        0x02,                  // Properties Length
+        0x01, 0x01,            // Payload Format Indicator
+        0xC3, 0x28             // Invalid UTF-8 Payload
+    };
+
+    client.pushToReadBuffer((void *)publish, sizeof(publish));
+
+    mqttClient.sync();
+
+    ASSERT_TRUE(handler.topicQueue.empty());
+    ASSERT_FALSE(mqttClient.connected());
+    ASSERT_NE(client.getWriteBuffer(), nullptr);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[0], 0xE0);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[2], ReasonCode::PAYLOAD_FORMAT_INVALID);
+}
+
+TEST(MqttClientTests, InvalidTopics)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MqttClient mqttClient(clientPtr);
+
+    setupConnected(client, mqttClient);
+
+    EncodedString wildcard("sport/+", 7);
+    Payload payload;
+
+    ASSERT_EQ(mqttClient.publish(wildcard, payload, QoS::ONE), (uint16_t)-1);
+
+    SubscribePayload invalid;
+    invalid.setTopic("sport/tennis#", 13);
+
+    ASSERT_EQ(mqttClient.subscribe(invalid), -1);
+
+    UnsubscribePayload empty;
+
+    ASSERT_EQ(mqttClient.unsubscribe(empty), -1);
+    ASSERT_EQ(client.getWriteBuffer(), nullptr);
+
+    SubscribePayload valid;
+    valid.setTopic("sport/+/player1", 15);
+
+    ASSERT_NE(mqttClient.subscribe(valid), -1);
+    ASSERT_NE(client.getWriteBuffer(), nullptr);
+}
+
+TEST(MqttClientTests, ViewHandler)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    MqttViewTestHandler handler;
+
+    MqttClient mqttClient(clientPtr);
+    mqttClient.setHandler((MqttClientHandlerV2 *)&handler);
+
+    setupConnected(client, mqttClient);
+
+    ASSERT_EQ(handler.connectionResult, 0);
+
+    const unsigned char publish[] = {
+        0x3B,                                  // Publish ID with QoS 1, Duplicate and Retain
+        0x14,                                  // Remaining Length
+        0x00, 0x08,                            // Length of topic (Big Endian Ordering)
+        'm', 'y', '/', 't', 'o', 'p', 'i', 'c', // Topic
+        0x01, 0x02,                            // Packet Identifier
+        0x05,                                  // Properties Length
+        0x02, 0x00, 0x00, 0x00, 0x3C,          // Message Expiry Interval
+        'h', 'i'                               // Payload
+    };
+
+    client.pushToReadBuffer((void *)publish, sizeof(publish));
+
+    mqttClient.sync();
+
+    ASSERT_EQ(handler.topicQueue.size(), 1);
+    ASSERT_EQ(handler.topicQueue.front(), "my/topic");
+    ASSERT_EQ(handler.payloadQueue.front(), vector<uint8_t>({'h', 'i'}));
+
+    auto [qos, retain, duplicate, token, expiry] = handler.metadataQueue.front();
+
+    ASSERT_EQ(qos, QoS::ONE);
+    ASSERT_TRUE(retain);
+    ASSERT_TRUE(duplicate);
+    ASSERT_EQ(token, 0x0201);
+    ASSERT_TRUE(expiry);
+
+    const unsigned char subscribeAcknowledge[] = {
+        0x90,       // ID
+        0x05,       // Remaining Length
+        0x03, 0x00, // Packet Identifier
+        0x00,       // No properties
+        0x01, 0x80  // Reason Codes
+    };
+
+    client.pushToReadBuffer((void *)subscribeAcknowledge, sizeof(subscribeAcknowledge));
+
+    mqttClient.sync();
+
+    ASSERT_EQ(handler.subscribeResult.size(), 1);
+    ASSERT_EQ(handler.subscribeResult[0x0003], vector<uint8_t>({0x01, 0x80}));
+}
+
+TEST(MqttClientTests, Stats)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MqttClient mqttClient(clientPtr);
+
+    setupConnected(client, mqttClient);
+
+    const MqttClientStats &stats = mqttClient.getStats();
+
+    ASSERT_EQ(stats.getPacketsSent(PacketId::CONNECT), 1);
+    ASSERT_EQ(stats.getPacketsReceived(PacketId::CONNECT_ACKNOWLEDGE), 1);
+
+    EncodedString topic("my/topic", 8);
+    Payload payload;
+
+    uint16_t first = mqttClient.publish(topic, payload, QoS::ONE);
+    mqttClient.publish(topic, payload, QoS::ONE);
+
+    ASSERT_EQ(stats.getPacketsSent(PacketId::PUBLISH), 2);
+    ASSERT_EQ(stats.getInflight(), 2);
+
+    const unsigned char puback[] = {
+        0x40,                    // ID
+        0x04,                    // Variable Length
+        (uint8_t)(first & 0xFF), // Packet Identifier Lower
+        (uint8_t)(first >> 8),   // Packet Identifier Upper
+        0x00,                    // Reason Code
+        0x00                     // No properties
+    };
+
+    size_t received = stats.getBytesReceived();
+
+    client.pushToReadBuffer((void *)puback, sizeof(puback));
+
+    mqttClient.sync();
+
+    ASSERT_EQ(stats.getPacketsReceived(PacketId::PUBLISH_ACKNOWLEDGE), 1);
+    ASSERT_EQ(stats.getBytesReceived(), received + sizeof(puback));
+    ASSERT_EQ(stats.getInflight(), 1);
+    ASSERT_EQ(stats.getPeakInflight(), 2);
+
+    MqttClientStatsSnapshot snapshot = stats.snapshot();
+    char buffer[4096];
+
+    ASSERT_GT(exportPrometheus(snapshot, buffer, sizeof(buffer)), 0);
+    ASSERT_NE(strstr(buffer, "mqtt_client_sent_packets_total{type=\"publish\"} 2\n"), nullptr);
+    ASSERT_NE(strstr(buffer, "mqtt_client_inflight_messages_peak 2\n"), nullptr);
+
+    ASSERT_GT(exportJson(snapshot, buffer, sizeof(buffer)), 0);
+    ASSERT_NE(strstr(buffer, "\"peakInflight\":2"), nullptr);
+    ASSERT_NE(strstr(buffer, "\"packetsSent\":{\"connect\":1,\"connack\":0,\"publish\":2"), nullptr);
+
+    // Output that does not fit is rejected rather than truncated
+    ASSERT_EQ(exportJson(snapshot, buffer, 16), -1);
+    ASSERT_EQ(exportPrometheus(snapshot, buffer, 16), -1);
+}
+
+TEST(MqttClientTests, DeliveryLatency)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MqttClient mqttClient(clientPtr);
+
+    int sensors = mqttClient.addLatencyTopicPrefix("sensors/", 8);
+
+    setupConnected(client, mqttClient);
+
+    ASSERT_EQ(mqttClient.getDeliveryLatency(QoS::ZERO), nullptr);
+    ASSERT_EQ(mqttClient.getDeliveryLatency(QoS::ONE, sensors + 1), nullptr);
+
+    EncodedString sensorTopic("sensors/1", 9);
+    EncodedString otherTopic("my/topic", 8);
+    Payload payload;
+
+    uint16_t tokens[] = {mqttClient.publish(sensorTopic, payload, QoS::ONE),
+                         mqttClient.publish(otherTopic, payload, QoS::ONE),
+                         mqttClient.publish(otherTopic, payload, QoS::TWO)};
+
+    for (uint16_t token : tokens)
+    {
+        const unsigned char acknowledge[] = {
+            (token == tokens[2]) ? (uint8_t)0x70 : (uint8_t)0x40, // PUBCOMP or PUBACK ID
+            0x04,                                                 // Variable Length
+            (uint8_t)(token & 0xFF),                              // Packet Identifier Lower
+            (uint8_t)(token >> 8),                                // Packet Identifier Upper
+            0x00,                                                 // Reason Code
+            0x00                                                  // No properties
+        };
+
+        client.pushToReadBuffer((void *)acknowledge, sizeof(acknowledge));
+        mqttClient.sync();
+
+        ASSERT_TRUE(mqttClient.isDelivered(token));
+    }
+
+    ASSERT_EQ(mqttClient.getDeliveryLatency(QoS::ONE)->getCount(), 2);
+    ASSERT_EQ(mqttClient.getDeliveryLatency(QoS::TWO)->getCount(), 1);
+    ASSERT_EQ(mqttClient.getDeliveryLatency(QoS::ONE, sensors)->getCount(), 1);
+    ASSERT_EQ(mqttClient.getDeliveryLatency(QoS::TWO, sensors)->getCount(), 0);
+}
+
+class StepClock : public Clock
+{
+public:
+    uint64_t now = 0;
+
+    uint64_t microseconds() override
+    {
+        return now;
+    }
+};
+
+TEST(MqttClientTests, ClockDrivesKeepAlive)
+{
+    StepClock clock;
+    setDefaultClock(&clock);
+
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MqttClient mqttClient(clientPtr);
+
+    mqttClient.setKeepAliveInterval(1);
+
+    setupConnected(client, mqttClient);
+
+    client.clearWriteBuffer();
+
+    // Sub-millisecond steps must accumulate rather than be truncated away
+    for (uint32_t elapsed = 300; elapsed < 1000000; elapsed += 300)
+    {
+        clock.now += 300;
+        mqttClient.sync();
+        ASSERT_EQ(client.getWriteBuffer(), nullptr) << "at " << elapsed << "us";
+    }
+
+    clock.now += 300;
+    mqttClient.sync();
+
+    ASSERT_NE(client.getWriteBuffer(), nullptr);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[0], 0xC0);
+
+    setDefaultClock(NULL);
+}
+
+TEST(MqttClientTests, SharedTimerWheel)
+{
+    TimerWheel timers;
+
+    MockClient firstClient;
+    MockClient secondClient;
+
+    MockMqttClient first((Client *)&firstClient);
+    MockMqttClient second((Client *)&secondClient);
+
+    first.setTimerWheel(&timers);
+    second.setTimerWheel(&timers);
+
+    first.setKeepAliveInterval(1);
+    second.setKeepAliveInterval(1);
+
+    setupConnected(firstClient, first);
+    setupConnected(secondClient, second);
+
+    firstClient.clearWriteBuffer();
+    secondClient.clearWriteBuffer();
+
+    // A shared wheel is advanced by its owner, not by each client
+    first.setElapsedTime(1000);
+    first.sync();
+
+    ASSERT_EQ(firstClient.getWriteBuffer(), nullptr);
+
+    timers.advance(1000);
+
+    first.sync();
+    second.sync();
+
+    ASSERT_NE(firstClient.getWriteBuffer(), nullptr);
+    ASSERT_NE(secondClient.getWriteBuffer(), nullptr);
+    ASSERT_EQ((uint8_t)firstClient.getWriteBuffer()[0], 0xC0);
+    ASSERT_EQ((uint8_t)secondClient.getWriteBuffer()[0], 0xC0);
+}
+
+TEST(MqttClientTests, WaitTimeout)
+{
+    StepClock clock;
+    setDefaultClock(&clock);
+
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MqttClient mqttClient(clientPtr);
+
+    ASSERT_EQ(mqttClient.getFileDescriptor(), -1);
+    ASSERT_FALSE(mqttClient.wantsRead());
+    ASSERT_EQ(mqttClient.getTimeout(), -1);
+
+    mqttClient.setKeepAliveInterval(1);
+
+    setupConnected(client, mqttClient);
+
+    ASSERT_TRUE(mqttClient.wantsRead());
+    ASSERT_FALSE(mqttClient.wantsWrite());
+    ASSERT_EQ(mqttClient.getTimeout(), 1000);
+
+    // Rounded up, so waiting the full timeout always reaches the deadline
+    clock.now += 250300;
+    ASSERT_EQ(mqttClient.getTimeout(), 750);
+
+    clock.now += 749000;
+    ASSERT_EQ(mqttClient.getTimeout(), 1);
+
+    mqttClient.sync();
+
+    ASSERT_EQ(client.getWriteBuffer(), nullptr);
+    ASSERT_EQ(mqttClient.getTimeout(), 1);
+
+    clock.now += 1000;
+    mqttClient.sync();
+
+    ASSERT_NE(client.getWriteBuffer(), nullptr);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[0], 0xC0);
+
+    // Waiting on the ping response
+    ASSERT_EQ(mqttClient.getTimeout(), 500);
+
+    const unsigned char response[] = {0xD0, 0x00};
+    client.pushToReadBuffer((void *)response, sizeof(response));
+
+    ASSERT_EQ(mqttClient.getTimeout(), 0);
+
+    setDefaultClock(NULL);
+}
+
+TEST(MqttClientTests, MessageExpiry)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MqttClient mqttClient(clientPtr);
+
+    setupConnected(client, mqttClient);
+
+    client.clearWriteBuffer();
+
+    EncodedString topic("my/topic", 8);
+    uint8_t data[] = {0xAB};
+    Payload payload(data, sizeof(data));
+
+    mqttClient.setMessageExpiryInterval(60);
+    mqttClient.publish(topic, payload, QoS::ZERO);
+
+    // A publish's own interval replaces the default
+    mqttClient.publish(topic, payload, QoS::ZERO, false, {.messageExpiry = 0x01020304});
+    mqttClient.publish(topic, payload, QoS::ZERO, false, {.messageExpiry = MESSAGE_EXPIRY_NEVER});
+
+    uint8_t expectedData[] = {
+        0x30, 0x11,                                           // Publish, Remaining Length
+        0x00, 0x08, 'm', 'y', '/', 't', 'o', 'p', 'i', 'c', // Topic
+        0x05, 0x02, 0x00, 0x00, 0x00, 0x3C,                   // Message Expiry Interval
+        0xAB,                                                 // Payload
+        0x30, 0x11,
+        0x00, 0x08, 'm', 'y', '/', 't', 'o', 'p', 'i', 'c',
+        0x05, 0x02, 0x01, 0x02, 0x03, 0x04,
+        0xAB,
+        0x30, 0x0C,
+        0x00, 0x08, 'm', 'y', '/', 't', 'o', 'p', 'i', 'c',
+        0x00, // No properties
+        0xAB};
+
+    ASSERT_EQ(client.written(), sizeof(expectedData));
+
+    for (size_t i = 0; i < sizeof(expectedData); i++)
+    {
+        ASSERT_EQ((uint8_t)client.getWriteBuffer()[i], expectedData[i]) << "at position " << i;
+    }
+}
+
+TEST(MqttClientTests, BytesReceivedAcrossReads)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MqttClient mqttClient(clientPtr);
+
+    setupConnected(client, mqttClient);
+
+    const MqttClientStats &stats = mqttClient.getStats();
+    size_t received = stats.getBytesReceived();
+
+    uint8_t first[] = {
+        0x30, 0x07,      // Publish QoS 0, Remaining Length
+        0x00, 0x01, 'a', // Topic
+        0x02, 0x01       // Properties Length, start of a Payload Format Indicator
+    };
+    uint8_t second[] = {
+        0x00, // Payload Format Indicator value
+        'x'   // Payload
+    };
+
+    // The packet arrives in two parts, split inside its properties
+    client.pushToReadBuffer(first, sizeof(first));
+    mqttClient.sync();
+    client.pushToReadBuffer(second, sizeof(second));
+    mqttClient.sync();
+
+    ASSERT_EQ(stats.getPacketsReceived(PacketId::PUBLISH), 1);
+    ASSERT_EQ(stats.getBytesReceived(), received + sizeof(first) + sizeof(second));
+}
+
+TEST(MqttClientTests, QueuedMessageExpiry)
+{
+    StepClock clock;
+    setDefaultClock(&clock);
+
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    MqttTestHandler handler;
+
+    MqttClient mqttClient(clientPtr);
+    mqttClient.setHandler((MqttClientHandler *)&handler);
+
+    setupConnected(client, mqttClient);
+
+    client.clearWriteBuffer();
+    client.setWritePending(true);
+
+    EncodedString topic("a", 1);
+    Payload payload;
+
+    Token kept = mqttClient.publish(topic, payload, QoS::ONE, false, {.messageExpiry = 10});
+    Token expired = mqttClient.publish(topic, payload, QoS::ZERO, false, {.messageExpiry = 2});
+
+    // Held while the transport is congested
+    ASSERT_EQ(client.getWriteBuffer(), nullptr);
+    ASSERT_FALSE(mqttClient.isDelivered(kept));
+    ASSERT_TRUE(mqttClient.wantsWrite());
+    ASSERT_EQ(mqttClient.getTimeout(), 2000);
+    ASSERT_EQ(mqttClient.getStats().getQueueDepth(), 2);
+
+    clock.now += 3000000;
+    mqttClient.sync();
+
+    ASSERT_EQ(mqttClient.getStats().getQueueDepth(), 1);
+
+    ASSERT_EQ(handler.deliveryFailureQueue.size(), 1);
+    ASSERT_EQ(get<0>(handler.deliveryFailureQueue.front()), expired);
+    ASSERT_EQ(get<1>(handler.deliveryFailureQueue.front()), (uint8_t)MESSAGE_EXPIRED);
+    ASSERT_EQ(client.getWriteBuffer(), nullptr);
+
+    client.setWritePending(false);
+    mqttClient.sync();
+
+    ASSERT_EQ(mqttClient.getStats().getQueueDepth(), 0);
+
+    // Sent with the time it has left
+    uint8_t expectedData[] = {
+        0x32, 0x0B,                        // Publish QoS 1, Remaining Length
+        0x00, 0x01, 'a',                   // Topic
+        (uint8_t)kept, (uint8_t)(kept >> 8), // Packet Identifier Lower, Upper
+        0x05, 0x02, 0x00, 0x00, 0x00, 0x07 // Message Expiry Interval
+    };
+
+    ASSERT_EQ(client.written(), sizeof(expectedData));
+
+    for (size_t i = 0; i < sizeof(expectedData); i++)
+    {
+        ASSERT_EQ((uint8_t)client.getWriteBuffer()[i], expectedData[i]) << "at position " << i;
+    }
+
+    ASSERT_FALSE(mqttClient.isDelivered(kept));
+    ASSERT_FALSE(mqttClient.wantsWrite());
+
+    setDefaultClock(NULL);
+}
+
+TEST(MqttClientTests, QueuedPreparedMessageExpiry)
+{
+    StepClock clock;
+    setDefaultClock(&clock);
+
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    MqttTestHandler handler;
+
+    MqttClient mqttClient(clientPtr);
+    mqttClient.setHandler((MqttClientHandler *)&handler);
+    mqttClient.setMessageExpiryInterval(2);
+
+    setupConnected(client, mqttClient);
+
+    client.clearWriteBuffer();
+    client.setWritePending(true);
+
+    EncodedString topic("a", 1);
+    Payload payload;
+    Properties properties;
+
+    properties.addProperty(new PayloadFormatIndicatorProperty(0));
+    properties.addProperty(new MessageExpiryIntervalProperty(10));
+
+    // One prepared with its own interval, the other takes the client default
+    PreparedPublish withExpiry(topic, QoS::ONE, false, &properties);
+    PreparedPublish withDefault(topic, QoS::ZERO);
+
+    Token kept = mqttClient.publish(withExpiry, payload);
+    Token expired = mqttClient.publish(withDefault, payload);
+
+    ASSERT_EQ(mqttClient.getStats().getQueueDepth(), 2);
+    ASSERT_EQ(mqttClient.getTimeout(), 2000);
+
+    clock.now += 3000000;
+    mqttClient.sync();
+
+    ASSERT_EQ(handler.deliveryFailureQueue.size(), 1);
+    ASSERT_EQ(get<0>(handler.deliveryFailureQueue.front()), expired);
+    ASSERT_EQ(get<1>(handler.deliveryFailureQueue.front()), (uint8_t)MESSAGE_EXPIRED);
+    ASSERT_EQ(client.getWriteBuffer(), nullptr);
+
+    client.setWritePending(false);
+    mqttClient.sync();
+
+    // Sent with the time it has left
+    uint8_t expectedData[] = {
+        0x32, 0x0D,                          // Publish QoS 1, Remaining Length
+        0x00, 0x01, 'a',                     // Topic
+        (uint8_t)kept, (uint8_t)(kept >> 8), // Packet Identifier Lower, Upper
+        0x07,                                // Properties Length
+        0x01, 0x00,                          // Payload Format Indicator
+        0x02, 0x00, 0x00, 0x00, 0x07         // Message Expiry Interval
+    };
+
+    ASSERT_EQ(client.written(), sizeof(expectedData));
+
+    for (size_t i = 0; i < sizeof(expectedData); i++)
+    {
+        ASSERT_EQ((uint8_t)client.getWriteBuffer()[i], expectedData[i]) << "at position " << i;
+    }
+
+    ASSERT_EQ(mqttClient.getStats().getQueueDepth(), 0);
+
+    setDefaultClock(NULL);
+}
+
+TEST(MqttClientTests, PriorityLanes)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MockMqttClient mqttClient(clientPtr);
+
+    mqttClient.setKeepAliveInterval(1);
+
+    setupConnected(client, mqttClient);
+
+    client.clearWriteBuffer();
+    client.setWritePending(true);
+
+    EncodedString topic("a", 1);
+    PublishPriority priorities[] = {PublishPriority::BULK, PublishPriority::NORMAL, PublishPriority::URGENT, PublishPriority::NORMAL};
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        uint8_t data[] = {i};
+        Payload payload(data, sizeof(data));
+        mqttClient.publish(topic, payload, QoS::ZERO, false, {.priority = priorities[i]});
+    }
+
+    ASSERT_EQ(client.getWriteBuffer(), nullptr);
+
+    // The keep alive does not wait for queued publishes
+    mqttClient.setElapsedTime(1000);
+    mqttClient.sync();
+
+    ASSERT_EQ(client.written(), 2);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[0], 0xC0);
+
+    client.clearWriteBuffer();
+    client.setWritePending(false);
+    mqttClient.sync();
+
+    // Each publish is 7 bytes with its payload last, highest priority first then oldest first
+    ASSERT_EQ(client.written(), 28);
+    ASSERT_EQ(client.getWriteBuffer()[6], 2);
+    ASSERT_EQ(client.getWriteBuffer()[13], 1);
+    ASSERT_EQ(client.getWriteBuffer()[20], 3);
+    ASSERT_EQ(client.getWriteBuffer()[27], 0);
+}
+
+TEST(MqttClientTests, ControlAtPacketBoundary)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MockMqttClient mqttClient(clientPtr);
+
+    mqttClient.setKeepAliveInterval(1);
+
+    setupConnected(client, mqttClient);
+
+    client.clearWriteBuffer();
+
+    EncodedString topic("a", 1);
+    Payload bulk(100);
+    memset(bulk.getData(), 0xAB, 100);
+    uint8_t data[] = {0xCD};
+    Payload urgent(data, sizeof(data));
+
+    // The transport only takes the start of the bulk publish
+    client.setWriteCapacity(10);
+    mqttClient.publish(topic, bulk, QoS::ZERO, false, {.priority = PublishPriority::BULK});
+    mqttClient.publish(topic, urgent, QoS::ZERO, false, {.priority = PublishPriority::URGENT});
+
+    mqttClient.setElapsedTime(1000);
+    mqttClient.sync();
+
+    ASSERT_EQ(client.written(), 10);
+
+    client.setWriteCapacity(SIZE_MAX);
+    mqttClient.sync();
+
+    // The bulk publish is finished first, then the ping goes ahead of the queued publish
+    ASSERT_EQ(client.written(), 106 + 2 + 7);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[105], 0xAB);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[106], 0xC0);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[108], 0x30);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[114], 0xCD);
+}
+
+TEST(MqttClientTests, ReconnectAfterServerDisconnect)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    MqttTestHandler handler;
+
+    MockMqttClient mqttClient(clientPtr);
+    mqttClient.setHandler((MqttClientHandler *)&handler);
+
+    mqttClient.setAutoReconnect(100);
+
+    setupConnected(client, mqttClient);
+
+    const unsigned char disconnect[] = {
+        0xE0, 0x02, // Disconnect, Remaining Length
+        0x8B,       // Server shutting down
+        0x00        // No properties
+    };
+
+    client.pushToReadBuffer((void *)disconnect, sizeof(disconnect));
+    mqttClient.sync();
+
+    ASSERT_FALSE(mqttClient.connected());
+
+    // The server closes the socket after its DISCONNECT
+    client.setIsConnected(false);
+    mqttClient.sync();
+
+    ASSERT_NE(mqttClient.getTimeout(), -1);
+
+    mqttClient.setElapsedTime(101);
+    mqttClient.sync();
+
+    ASSERT_EQ(mqttClient.getReconnectStatistics().attempts, 1);
+}
+
+TEST(MqttClientTests, KeepAliveTimeoutReconnects)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MockMqttClient mqttClient(clientPtr);
+
+    mqttClient.setKeepAliveInterval(1);
+    mqttClient.setAutoReconnect(100);
+
+    setupConnected(client, mqttClient);
+
+    // Pings go unanswered until the server keep alive of one and a half intervals expires
+    mqttClient.setElapsedTime(1500);
+    mqttClient.sync();
+
+    ASSERT_FALSE(mqttClient.connected());
+    ASSERT_FALSE(client.connected());
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[client.written() - 4], 0xE0);
+    ASSERT_EQ((uint8_t)client.getWriteBuffer()[client.written() - 2], ReasonCode::KEEP_ALIVE_TIMEOUT);
+
+    // No second CONNECT is written on the closed connection
+    client.clearWriteBuffer();
+    mqttClient.sync();
+
+    ASSERT_EQ(client.getWriteBuffer(), nullptr);
+
+    mqttClient.setElapsedTime(101);
+    mqttClient.sync();
+
+    ASSERT_EQ(mqttClient.getReconnectStatistics().attempts, 1);
+}
+
+TEST(MqttClientTests, DisconnectDoesNotReconnect)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MockMqttClient mqttClient(clientPtr);
+
+    mqttClient.setAutoReconnect(100);
+
+    setupConnected(client, mqttClient);
+
+    ASSERT_EQ(mqttClient.disconnect(ReasonCode::NORMAL_DISCONNECTION), 0);
+    ASSERT_FALSE(client.connected());
+
+    mqttClient.setElapsedTime(1000);
+    mqttClient.sync();
+
+    ASSERT_EQ(mqttClient.getReconnectStatistics().attempts, 0);
+    ASSERT_EQ(mqttClient.getTimeout(), -1);
+}
+
+TEST(MqttClientTests, RetriesInitialConnect)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+
+    MockMqttClient mqttClient(clientPtr);
+
+    mqttClient.setAutoReconnect(100);
+
+    ASSERT_EQ(mqttClient.connect("localhost", 1883, 0), -1);
+
+    mqttClient.setElapsedTime(101);
+    mqttClient.sync();
+
+    ASSERT_EQ(mqttClient.getReconnectStatistics().attempts, 1);
+}
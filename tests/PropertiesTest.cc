@@ -145,4 +145,160 @@ TEST(PropertiesTest, Encode)
             ASSERT_EQ(data[i], testData[i]) << "at position " << i;
         }
     }
-}
\ No newline at end of file
+}
+
+static uint8_t propertyBlock[] = {
+    0x12,                           // Properties Length
+    0x21, 0x00, 0x0A,               // Receive Maximum
+    0x22, 0x00, 0x05,               // Topic Alias Maximum
+    0x1F, 0x00, 0x02, 'o', 'k',     // Reason String
+    0x26, 0x00, 0x01, 'k', 0x00, 0x01, 'v' // User Property
+};
+
+TEST(PropertiesTest, ReadFromClient)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    Properties properties;
+    uint32_t read = 0;
+
+    client.pushToReadBuffer(propertyBlock, sizeof(propertyBlock));
+
+    ASSERT_FALSE(properties.readFromClient(clientPtr, read));
+    ASSERT_EQ(read, sizeof(propertyBlock));
+    ASSERT_EQ(properties.length(), 4);
+
+    EXPECT_EQ(((WordProperty *)properties.get(RECEIVE_MAXIMUM))->getValue(), 10);
+    EXPECT_EQ(((WordProperty *)properties.get(TOPIC_ALIAS_MAXIMUM))->getValue(), 5);
+
+    EncodedString reason = ((StringProperty *)properties.get(REASON_STRING))->getValue();
+    ASSERT_EQ(reason.size(), 4);
+    EXPECT_EQ(memcmp(reason.data, "ok", 2), 0);
+
+    StringPairProperty *user = (StringPairProperty *)properties.get(USER_PROPERTY);
+    ASSERT_NE(user, nullptr);
+    EXPECT_EQ(user->getKey().data[0], 'k');
+    EXPECT_EQ(user->getValue().data[0], 'v');
+
+    // Writing the block back out reproduces the original bytes
+    PacketBuffer buffer(properties.totalSize());
+    ASSERT_EQ(properties.push(buffer), sizeof(propertyBlock));
+
+    for (size_t i = 0; i < sizeof(propertyBlock); i++)
+    {
+        ASSERT_EQ(buffer.getBuffer()[i], propertyBlock[i]) << "at position " << i;
+    }
+}
+
+TEST(PropertiesTest, ArenaReuse)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    Properties properties;
+    uint32_t read = 0;
+
+    client.pushToReadBuffer(propertyBlock, sizeof(propertyBlock));
+    properties.readFromClient(clientPtr, read);
+
+    Property *first = properties.get(RECEIVE_MAXIMUM);
+    Property *last = properties.get(USER_PROPERTY);
+
+    // Properties added by the caller are owned alongside decoded ones
+    properties.addProperty(new SessionExpiryInterval(30));
+
+    properties.clear();
+
+    client.pushToReadBuffer(propertyBlock, sizeof(propertyBlock));
+    properties.readFromClient(clientPtr, read);
+
+    // A repeated block is decoded into the same memory
+    EXPECT_EQ(properties.get(RECEIVE_MAXIMUM), first);
+    EXPECT_EQ(properties.get(USER_PROPERTY), last);
+    EXPECT_EQ(((WordProperty *)properties.get(RECEIVE_MAXIMUM))->getValue(), 10);
+}
+
+TEST(PropertiesTest, Index)
+{
+    Properties properties;
+
+    EXPECT_FALSE(properties.has(USER_PROPERTY));
+    EXPECT_EQ(properties.get(SHARED_SUBSCRIPTION_AVAILABLE), nullptr);
+
+    properties.addProperty(new UserProperty(EncodedString("a", 1), EncodedString("1", 1)));
+    properties.addProperty(new SubscriptionIdentifier(4));
+    properties.addProperty(new SharedSubscriptionAvailable(1));
+    properties.addProperty(new UserProperty(EncodedString("b", 1), EncodedString("2", 1)));
+    properties.addProperty(new SubscriptionIdentifier(9));
+    properties.addProperty(new UserProperty(EncodedString("c", 1), EncodedString("3", 1)));
+
+    ASSERT_TRUE(properties.has(SHARED_SUBSCRIPTION_AVAILABLE));
+    EXPECT_EQ(((ByteProperty *)properties.get(SHARED_SUBSCRIPTION_AVAILABLE))->getValue(), 1);
+    EXPECT_FALSE(properties.has(REASON_STRING));
+
+    const char expectedKeys[] = {'a', 'b', 'c'};
+    size_t index = 0;
+
+    for (Property *property : properties.all(USER_PROPERTY))
+    {
+        ASSERT_LT(index, sizeof(expectedKeys));
+        EXPECT_EQ(((UserProperty *)property)->getKey().data[0], expectedKeys[index++]);
+    }
+
+    EXPECT_EQ(index, sizeof(expectedKeys));
+
+    uint32_t total = 0;
+
+    properties.each<SubscriptionIdentifier>(
+        SUBSCRIPTION_IDENTIFIER,
+        [&total](SubscriptionIdentifier *property)
+        {
+            total += property->getValue().value;
+            return true;
+        });
+
+    EXPECT_EQ(total, 13);
+
+    properties.clear();
+
+    EXPECT_FALSE(properties.has(USER_PROPERTY));
+    EXPECT_FALSE(properties.all(SUBSCRIPTION_IDENTIFIER).begin() != properties.all(SUBSCRIPTION_IDENTIFIER).end());
+}
+
+TEST(PropertiesTest, LazyDecoding)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    Properties properties;
+    uint32_t read = 0;
+
+    properties.setLazy(true);
+
+    client.pushToReadBuffer(propertyBlock, sizeof(propertyBlock));
+
+    ASSERT_FALSE(properties.readFromClient(clientPtr, read));
+    ASSERT_EQ(read, sizeof(propertyBlock));
+
+    // The raw block is written back untouched
+    ASSERT_EQ(properties.totalSize(), sizeof(propertyBlock));
+
+    PacketBuffer buffer(properties.totalSize());
+    ASSERT_EQ(properties.push(buffer), sizeof(propertyBlock));
+
+    for (size_t i = 0; i < sizeof(propertyBlock); i++)
+    {
+        ASSERT_EQ(buffer.getBuffer()[i], propertyBlock[i]) << "at position " << i;
+    }
+
+    StringPairProperty *user = (StringPairProperty *)properties.get(USER_PROPERTY);
+    ASSERT_NE(user, nullptr);
+    EXPECT_EQ(user->getValue().data[0], 'v');
+    EXPECT_EQ(properties.get(USER_PROPERTY), user);
+
+    EXPECT_FALSE(properties.has(CONTENT_TYPE));
+    EXPECT_EQ(((WordProperty *)properties.get(TOPIC_ALIAS_MAXIMUM))->getValue(), 5);
+
+    ASSERT_EQ(properties.length(), 4);
+    EXPECT_EQ(properties.get(USER_PROPERTY), user);
+    EXPECT_EQ(((WordProperty *)properties.get(RECEIVE_MAXIMUM))->getValue(), 10);
+    EXPECT_EQ(properties.totalSize(), sizeof(propertyBlock));
+}
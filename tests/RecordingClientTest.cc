@@ -0,0 +1,159 @@
+/*
+ * File: RecordingClientTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "stdint.h"
+
+#include "mocks/MockClient.h"
+#include "MqttClient.h"
+#include "RecordingClient.h"
+#include "ReplayClient.h"
+#include "utils/MqttTestHandler.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+TEST(RecordingClientTest, ReplaysFragmentation)
+{
+    MockClient client;
+    FILE *capture = tmpfile();
+    RecordingClient recorder((Client *)&client, capture);
+    uint8_t data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint8_t output[9];
+
+    client.pushToReadBuffer(data, 3);
+    ASSERT_EQ(recorder.available(), 3);
+    ASSERT_EQ(recorder.read(output, 1), 1);
+
+    client.pushToReadBuffer(data + 3, 4);
+    ASSERT_EQ(recorder.available(), 6);
+    ASSERT_EQ(recorder.read(output + 1, 6), 6);
+    ASSERT_EQ(recorder.available(), 0);
+
+    client.pushToReadBuffer(data + 7, 2);
+    ASSERT_EQ(recorder.read(output + 7, 2), 2);
+
+    ASSERT_EQ(memcmp(output, data, sizeof(data)), 0);
+    ASSERT_EQ(recorder.getChunks(), 3);
+
+    rewind(capture);
+
+    ReplayClient replay;
+    ASSERT_EQ(replay.load(capture), 0);
+    fclose(capture);
+
+    memset(output, 0, sizeof(output));
+
+    ASSERT_EQ(replay.available(), 3);
+    ASSERT_EQ(replay.read(output, 1), 1);
+    // The second chunk arrived with two bytes unread, so it is held until the reader reaches the same point
+    ASSERT_EQ(replay.available(), 6);
+    ASSERT_EQ(replay.read(output + 1, 6), 6);
+    ASSERT_FALSE(replay.finished());
+    ASSERT_EQ(replay.available(), 2);
+    ASSERT_EQ(replay.read(output + 7, 2), 2);
+    ASSERT_EQ(replay.available(), 0);
+    ASSERT_TRUE(replay.finished());
+
+    ASSERT_EQ(memcmp(output, data, sizeof(data)), 0);
+
+    // Chunks are never revealed ahead of the reader
+    replay.rewind();
+    ASSERT_EQ(replay.available(), 3);
+    ASSERT_EQ(replay.available(), 3);
+}
+
+TEST(RecordingClientTest, InvalidCapture)
+{
+    ReplayClient replay;
+    const uint8_t wrongMagic[] = {'M', 'Q', 'T', 'T', CAPTURE_VERSION};
+    const uint8_t truncated[] = {'M', 'Q', 'R', 'C', CAPTURE_VERSION, 0x00, 0x00, 0x05, 0x01};
+
+    ASSERT_EQ(replay.load(wrongMagic, sizeof(wrongMagic)), -1);
+    ASSERT_EQ(replay.load(truncated, sizeof(truncated)), -1);
+}
+
+TEST(RecordingClientTest, ReplayIntoClient)
+{
+    MockClient client;
+    FILE *capture = tmpfile();
+    RecordingClient recorder((Client *)&client, capture);
+    MqttClient mqttClient((Client *)&recorder);
+
+    client.setIsConnected(true);
+    mqttClient.connect("localhost", 1883, 0);
+    mqttClient.sync();
+
+    const uint8_t connack[] = {0x20, 0x03, 0x00, 0x00, 0x00};
+    client.pushToReadBuffer((void *)connack, sizeof(connack));
+    mqttClient.sync();
+
+    ASSERT_TRUE(mqttClient.connected());
+
+    const uint8_t publish[] = {
+        0x30,                                  // Publish ID with QoS 0
+        0x0D,                                  // Remaining Length
+        0x00, 0x08,                            // Length of topic
+        'm', 'y', '/', 't', 'o', 'p', 'i', 'c', // Topic
+        0x00,                                  // No properties
+        'h', 'i'                               // Payload
+    };
+
+    // Split inside the topic
+    client.pushToReadBuffer((void *)publish, 6);
+    mqttClient.sync();
+    client.pushToReadBuffer((void *)(publish + 6), sizeof(publish) - 6);
+    mqttClient.sync();
+
+    rewind(capture);
+
+    ReplayClient replay;
+    ASSERT_EQ(replay.load(capture), 0);
+    fclose(capture);
+
+    MqttViewTestHandler handler;
+    MqttClient replayed((Client *)&replay);
+    replayed.setHandler((MqttClientHandlerV2 *)&handler);
+    replayed.connect("localhost", 1883, 0);
+
+    for (int i = 0; i < 10 && !replay.finished(); i++)
+    {
+        replayed.sync();
+    }
+
+    ASSERT_TRUE(replay.finished());
+    ASSERT_TRUE(replayed.connected());
+    ASSERT_EQ(handler.topicQueue.size(), 1);
+    ASSERT_EQ(handler.topicQueue.front(), "my/topic");
+    ASSERT_EQ(handler.payloadQueue.front(), vector<uint8_t>({'h', 'i'}));
+}
@@ -0,0 +1,185 @@
+/*
+ * File: AllocationCounter.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "AllocationCounter.h"
+#include <atomic>
+#include <new>
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ALLOCATION_COUNTER_SANITIZED
+#endif
+#endif
+
+#if defined(__SANITIZE_ADDRESS__)
+#define ALLOCATION_COUNTER_SANITIZED
+#endif
+
+static std::atomic<bool> tracking(false);
+static std::atomic<uint64_t> allocationCount(0);
+static std::atomic<uint64_t> releaseCount(0);
+
+static inline void countAllocation()
+{
+    if (tracking.load(std::memory_order_relaxed))
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+static inline void countRelease(void *pointer)
+{
+    if (pointer != NULL && tracking.load(std::memory_order_relaxed))
+    {
+        releaseCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#if defined(__GLIBC__) && !defined(ALLOCATION_COUNTER_SANITIZED)
+
+// glibc supports replacing malloc by defining these in the executable, the
+// originals stay reachable through their __libc_ aliases
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *pointer, size_t size);
+    void __libc_free(void *pointer);
+
+    void *malloc(size_t size)
+    {
+        countAllocation();
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t count, size_t size)
+    {
+        countAllocation();
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *pointer, size_t size)
+    {
+        countAllocation();
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void *pointer)
+    {
+        countRelease(pointer);
+        __libc_free(pointer);
+    }
+}
+
+bool allocationTrackingAvailable()
+{
+    return true;
+}
+
+#else
+
+bool allocationTrackingAvailable()
+{
+    return false;
+}
+
+#endif
+
+// The replaced operators forward to malloc and free, so they are counted once
+void *operator new(size_t size)
+{
+    void *pointer = malloc(size ? size : 1);
+
+    if (pointer == NULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return malloc(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return malloc(size ? size : 1);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+AllocationScope::AllocationScope()
+{
+    allocationStart = allocationCount.load();
+    releaseStart = releaseCount.load();
+    tracking.store(true);
+}
+
+AllocationScope::~AllocationScope()
+{
+    tracking.store(false);
+}
+
+uint64_t AllocationScope::allocations()
+{
+    return allocationCount.load() - allocationStart;
+}
+
+uint64_t AllocationScope::releases()
+{
+    return releaseCount.load() - releaseStart;
+}
@@ -0,0 +1,71 @@
+/*
+ * File: AllocationCounter.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef TESTS_ALLOCATION_ALLOCATIONCOUNTER
+#define TESTS_ALLOCATION_ALLOCATIONCOUNTER
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @brief Returns true when malloc and free are intercepted in this build.
+ * Interception is disabled under AddressSanitizer, which owns malloc itself.
+ */
+bool allocationTrackingAvailable();
+
+/**
+ * @brief Counts every heap allocation and release made while it is in scope,
+ * including malloc, calloc, realloc and the global operator new and delete.
+ * Scopes do not nest.
+ */
+class AllocationScope
+{
+private:
+    uint64_t allocationStart;
+    uint64_t releaseStart;
+
+public:
+    AllocationScope();
+    ~AllocationScope();
+
+    /**
+     * @brief The number of allocations made since the scope was opened
+     */
+    uint64_t allocations();
+
+    /**
+     * @brief The number of releases made since the scope was opened
+     */
+    uint64_t releases();
+};
+
+#endif /* TESTS_ALLOCATION_ALLOCATIONCOUNTER */
@@ -0,0 +1,287 @@
+/*
+ * File: HotPathAllocationTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+
+#include "AllocationCounter.h"
+#include "ScriptedClient.h"
+#include "mocks/MockMqttClient.h"
+#include "packets/PreparedPublish.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+// Iterations run before counting so pools, queues and buffers reach their working size
+#define WARM_UP_ITERATIONS 8
+#define MEASURED_ITERATIONS 256
+
+/**
+ * @brief Handler that drops every callback without touching the heap
+ */
+class NullHandler : public MqttClientHandlerV2
+{
+public:
+    uint32_t messages = 0;
+    uint32_t deliveries = 0;
+
+    void onConnectionSuccess() override{};
+    void onConnectionFailure(int) override{};
+    void onDisconnection(ReasonCode) override{};
+    void onDeliveryComplete(Token) override { deliveries++; };
+    void onDeliveryFailure(Token, int) override{};
+    void onMessage(string_view, span<const uint8_t>, const MessageMetadata &) override { messages++; };
+    void onSubscribeResult(Token, span<const uint8_t>) override{};
+    void onUnsubscribeResult(Token, span<const uint8_t>) override{};
+};
+
+class HotPathAllocationTest : public ::testing::Test
+{
+protected:
+    ScriptedClient client;
+    NullHandler handler;
+    MockMqttClient mqttClient;
+    EncodedString topic;
+    uint8_t data[64] = {0};
+
+    HotPathAllocationTest() : mqttClient((Client *)&client), topic("sensor/temperature", 18){};
+
+    void SetUp() override
+    {
+        if (!allocationTrackingAvailable())
+        {
+            GTEST_SKIP() << "malloc cannot be intercepted in this build";
+        }
+
+        mqttClient.setHandler((MqttClientHandlerV2 *)&handler);
+        mqttClient.setKeepAliveInterval(1);
+        mqttClient.connect("localhost", 1883, 0);
+        mqttClient.sync();
+
+        const uint8_t connack[] = {0x20, 0x03, 0x00, 0x00, 0x00};
+        client.script(connack, sizeof(connack));
+        mqttClient.sync();
+
+        ASSERT_TRUE(mqttClient.connected());
+        client.clearWritten();
+    }
+
+    /**
+     * @brief Scripts an acknowledgement for a packet identifier
+     */
+    void scriptAcknowledge(uint8_t header, uint16_t token)
+    {
+        const uint8_t acknowledge[] = {header, 0x02, (uint8_t)(token & 0xFF), (uint8_t)(token >> 8)};
+        client.script(acknowledge, sizeof(acknowledge));
+    }
+
+    /**
+     * @brief Runs an operation through a warm-up and returns the allocations of each measured iteration
+     */
+    template <typename Operation>
+    double allocationsPerOperation(Operation operation)
+    {
+        for (int i = 0; i < WARM_UP_ITERATIONS; i++)
+        {
+            operation();
+        }
+
+        AllocationScope scope;
+
+        for (int i = 0; i < MEASURED_ITERATIONS; i++)
+        {
+            operation();
+        }
+
+        return (double)scope.allocations() / MEASURED_ITERATIONS;
+    }
+};
+
+TEST_F(HotPathAllocationTest, PublishQos0)
+{
+    auto allocations = allocationsPerOperation(
+        [&]()
+        {
+            mqttClient.publish(topic, Payload::wrap(data, sizeof(data)), QoS::ZERO);
+            mqttClient.sync();
+        });
+
+    ASSERT_EQ(allocations, 0);
+    ASSERT_EQ(handler.deliveries, WARM_UP_ITERATIONS + MEASURED_ITERATIONS);
+}
+
+TEST_F(HotPathAllocationTest, PublishQos0WithExpiry)
+{
+    mqttClient.setMessageExpiryInterval(60);
+
+    auto allocations = allocationsPerOperation(
+        [&]()
+        {
+            mqttClient.publish(topic, Payload::wrap(data, sizeof(data)), QoS::ZERO);
+            mqttClient.sync();
+        });
+
+    ASSERT_EQ(allocations, 0);
+    ASSERT_EQ(handler.deliveries, WARM_UP_ITERATIONS + MEASURED_ITERATIONS);
+}
+
+TEST_F(HotPathAllocationTest, PublishQos1)
+{
+    auto allocations = allocationsPerOperation(
+        [&]()
+        {
+            uint16_t token = mqttClient.publish(topic, Payload::wrap(data, sizeof(data)), QoS::ONE);
+            scriptAcknowledge(0x40, token);
+            mqttClient.sync();
+        });
+
+    ASSERT_EQ(allocations, 0);
+    ASSERT_EQ(handler.deliveries, WARM_UP_ITERATIONS + MEASURED_ITERATIONS);
+}
+
+TEST_F(HotPathAllocationTest, PublishQos2)
+{
+    auto allocations = allocationsPerOperation(
+        [&]()
+        {
+            uint16_t token = mqttClient.publish(topic, Payload::wrap(data, sizeof(data)), QoS::TWO);
+            scriptAcknowledge(0x50, token);
+            mqttClient.sync();
+            scriptAcknowledge(0x70, token);
+            mqttClient.sync();
+        });
+
+    ASSERT_EQ(allocations, 0);
+    ASSERT_EQ(handler.deliveries, WARM_UP_ITERATIONS + MEASURED_ITERATIONS);
+}
+
+TEST_F(HotPathAllocationTest, PreparedPublish)
+{
+    PreparedPublish prepared(topic, QoS::ZERO);
+    Payload payload = Payload::wrap(data, sizeof(data));
+
+    auto allocations = allocationsPerOperation(
+        [&]()
+        {
+            mqttClient.publish(prepared, payload);
+            mqttClient.sync();
+        });
+
+    ASSERT_EQ(allocations, 0);
+}
+
+TEST_F(HotPathAllocationTest, ReceiveQos0)
+{
+    const uint8_t publish[] = {
+        0x30,                                  // Publish ID with QoS 0
+        0x0D,                                  // Remaining Length
+        0x00, 0x08,                            // Length of topic
+        'm', 'y', '/', 't', 'o', 'p', 'i', 'c', // Topic
+        0x00,                                  // No properties
+        'h', 'i'                               // Payload
+    };
+
+    auto allocations = allocationsPerOperation(
+        [&]()
+        {
+            client.script(publish, sizeof(publish));
+            mqttClient.sync();
+        });
+
+    ASSERT_EQ(allocations, 0);
+    ASSERT_EQ(handler.messages, WARM_UP_ITERATIONS + MEASURED_ITERATIONS);
+}
+
+TEST_F(HotPathAllocationTest, ReceiveQos1)
+{
+    const uint8_t publish[] = {
+        0x32,                                  // Publish ID with QoS 1
+        0x0F,                                  // Remaining Length
+        0x00, 0x08,                            // Length of topic
+        'm', 'y', '/', 't', 'o', 'p', 'i', 'c', // Topic
+        0x01, 0x01,                            // Packet Identifier
+        0x00,                                  // No properties
+        'h', 'i'                               // Payload
+    };
+
+    auto allocations = allocationsPerOperation(
+        [&]()
+        {
+            client.script(publish, sizeof(publish));
+            mqttClient.sync();
+        });
+
+    ASSERT_EQ(allocations, 0);
+    ASSERT_EQ(handler.messages, WARM_UP_ITERATIONS + MEASURED_ITERATIONS);
+}
+
+TEST_F(HotPathAllocationTest, ReceiveQos2)
+{
+    const uint8_t publish[] = {
+        0x34,                                  // Publish ID with QoS 2
+        0x0F,                                  // Remaining Length
+        0x00, 0x08,                            // Length of topic
+        'm', 'y', '/', 't', 'o', 'p', 'i', 'c', // Topic
+        0x01, 0x01,                            // Packet Identifier
+        0x00,                                  // No properties
+        'h', 'i'                               // Payload
+    };
+
+    auto allocations = allocationsPerOperation(
+        [&]()
+        {
+            client.script(publish, sizeof(publish));
+            mqttClient.sync();
+            scriptAcknowledge(0x62, 0x0101);
+            mqttClient.sync();
+        });
+
+    ASSERT_EQ(allocations, 0);
+    ASSERT_EQ(handler.messages, WARM_UP_ITERATIONS + MEASURED_ITERATIONS);
+}
+
+TEST_F(HotPathAllocationTest, KeepAlive)
+{
+    const uint8_t pingResponse[] = {0xD0, 0x00};
+
+    auto allocations = allocationsPerOperation(
+        [&]()
+        {
+            mqttClient.setElapsedTime(1000);
+            mqttClient.sync();
+            client.script(pingResponse, sizeof(pingResponse));
+            mqttClient.sync();
+        });
+
+    ASSERT_EQ(allocations, 0);
+    ASSERT_TRUE(mqttClient.connected());
+}
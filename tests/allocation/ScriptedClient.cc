@@ -0,0 +1,114 @@
+/*
+ * File: ScriptedClient.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "ScriptedClient.h"
+#include <string.h>
+
+int ScriptedClient::connect(const char *, uint16_t)
+{
+    isConnected = true;
+    return 1;
+}
+
+size_t ScriptedClient::write(uint8_t byte)
+{
+    return write(&byte, 1);
+}
+
+size_t ScriptedClient::write(const void *buffer, size_t size)
+{
+    // Once full, only the most recent writes are kept
+    if (writeLength + size > SCRIPTED_CLIENT_BUFFER_SIZE)
+    {
+        writeLength = 0;
+    }
+
+    if (size <= SCRIPTED_CLIENT_BUFFER_SIZE)
+    {
+        memcpy(writeBuffer + writeLength, buffer, size);
+        writeLength += size;
+    }
+
+    return size;
+}
+
+int ScriptedClient::available()
+{
+    return readLength - readPosition;
+}
+
+int ScriptedClient::read(void *buffer, size_t size)
+{
+    size_t remaining = readLength - readPosition;
+
+    if (size > remaining)
+    {
+        size = remaining;
+    }
+
+    memcpy(buffer, readBuffer + readPosition, size);
+    readPosition += size;
+
+    if (readPosition == readLength)
+    {
+        readPosition = readLength = 0;
+    }
+
+    return size;
+}
+
+void ScriptedClient::stop()
+{
+    isConnected = false;
+}
+
+uint8_t ScriptedClient::connected()
+{
+    return isConnected;
+}
+
+void ScriptedClient::sync()
+{
+}
+
+bool ScriptedClient::script(const void *buffer, size_t size)
+{
+    if (readLength + size > SCRIPTED_CLIENT_BUFFER_SIZE)
+    {
+        return false;
+    }
+
+    memcpy(readBuffer + readLength, buffer, size);
+    readLength += size;
+
+    return true;
+}
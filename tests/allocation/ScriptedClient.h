@@ -0,0 +1,80 @@
+/*
+ * File: ScriptedClient.h
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#ifndef TESTS_ALLOCATION_SCRIPTEDCLIENT
+#define TESTS_ALLOCATION_SCRIPTEDCLIENT
+
+#include "Client.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#define SCRIPTED_CLIENT_BUFFER_SIZE 4096
+
+/**
+ * @brief A transport backed by fixed buffers so it never allocates itself.
+ * Inbound bytes are scripted ahead of time and outbound bytes are kept until cleared.
+ */
+class ScriptedClient : public Client
+{
+private:
+    uint8_t readBuffer[SCRIPTED_CLIENT_BUFFER_SIZE];
+    size_t readPosition = 0;
+    size_t readLength = 0;
+
+    uint8_t writeBuffer[SCRIPTED_CLIENT_BUFFER_SIZE];
+    size_t writeLength = 0;
+
+    bool isConnected = true;
+
+public:
+    int connect(const char *host, uint16_t port) override;
+    size_t write(uint8_t) override;
+    size_t write(const void *buffer, size_t size) override;
+    int available() override;
+    int read(void *buffer, size_t size) override;
+    void stop() override;
+    uint8_t connected() override;
+    void sync() override;
+
+    /**
+     * @brief Appends bytes for the client to read
+     *
+     * @return false if the script buffer is full
+     */
+    bool script(const void *buffer, size_t size);
+
+    uint8_t *getWritten() { return writeBuffer; };
+    size_t getWrittenLength() { return writeLength; };
+    void clearWritten() { writeLength = 0; };
+};
+
+#endif /* TESTS_ALLOCATION_SCRIPTEDCLIENT */
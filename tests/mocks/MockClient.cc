@@ -35,7 +35,7 @@
 
 int MockClient::connect(const char *host, uint16_t port)
 {
-    return 1;
+    return isConnected ? 0 : 1;
 }
 
 size_t MockClient::write(uint8_t byte)
@@ -45,6 +45,16 @@ size_t MockClient::write(uint8_t byte)
 
 size_t MockClient::write(const void *buffer, size_t size)
 {
+    if (size > writeCapacity)
+    {
+        size = writeCapacity;
+    }
+
+    if (writeCapacity != SIZE_MAX)
+    {
+        writeCapacity -= size;
+    }
+
     if ((writeCount + size) > writeTotal)
     {
 
@@ -84,6 +94,7 @@ int MockClient::read(void *buffer, size_t size)
 
 void MockClient::stop()
 {
+    isConnected = false;
 }
 
 uint8_t MockClient::connected()
@@ -171,6 +182,21 @@ void MockClient::setIsConnected(bool connected)
     isConnected = connected;
 }
 
+bool MockClient::writePending()
+{
+    return pending;
+}
+
+void MockClient::setWritePending(bool value)
+{
+    pending = value;
+}
+
+void MockClient::setWriteCapacity(size_t bytes)
+{
+    writeCapacity = bytes;
+}
+
 size_t MockClient::written()
 {
     return writeCount;
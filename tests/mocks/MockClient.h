@@ -15,6 +15,8 @@ private:
     size_t readCount = 0;
     size_t writeCount = 0;
     bool isConnected = false;
+    bool pending = false;
+    size_t writeCapacity = SIZE_MAX;
 
 public:
     MockClient(){};
@@ -38,6 +40,7 @@ public:
     int read(void *buffer, size_t size);
     void stop();
     uint8_t connected();
+    bool writePending();
 
     bool resizeReadBuffer(size_t);
     bool resizeWriteBuffer(size_t);
@@ -49,6 +52,14 @@ public:
     bool pushToReadBuffer(void *buffer, size_t size);
 
     void setIsConnected(bool connected);
+    /**
+     * @brief Sets whether the client reports written data waiting on the transport
+     */
+    void setWritePending(bool value);
+    /**
+     * @brief Limits the amount of bytes further writes accept, SIZE_MAX for no limit
+     */
+    void setWriteCapacity(size_t bytes);
 
     size_t written();
 
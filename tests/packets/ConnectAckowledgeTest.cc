@@ -0,0 +1,87 @@
+/*
+ * File: ConnectAckowledgeTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+
+#include "packets/PacketUtility.h"
+#include "BufferClient.h"
+#include "PacketBuffer.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+TEST(ConnectAcknowledgeTest, Push)
+{
+    ConnectAcknowledge acknowledge;
+    acknowledge.setSessionPresent(true);
+    acknowledge.setReasonCode(ReasonCode::NOT_AUTHORIZED);
+
+    PacketBuffer buffer(acknowledge.totalSize());
+    acknowledge.push(buffer);
+
+    uint8_t expected[] = {
+        0x20, // Connect Acknowledge ID
+        0x03, // Remaining Length
+        0x01, // Session Present
+        0x87, // Reason Code
+        0x00  // Properties Length
+    };
+
+    ASSERT_EQ(buffer.getLength(), sizeof(expected));
+    ASSERT_EQ(memcmp(buffer.getBuffer(), expected, sizeof(expected)), 0);
+}
+
+TEST(ConnectAcknowledgeTest, PushAndRead)
+{
+    ConnectAcknowledge acknowledge;
+    acknowledge.setSessionPresent(true);
+    acknowledge.setReasonCode(ReasonCode::SUCCESS);
+
+    PacketBuffer buffer(acknowledge.totalSize());
+    acknowledge.push(buffer);
+
+    BufferClient client(buffer.getBuffer(), buffer.getLength());
+    PacketPool pool;
+
+    ConnectAcknowledge *read = (ConnectAcknowledge *)readPacketFromClient(&client, pool);
+
+    ASSERT_NE(read, nullptr);
+    EXPECT_EQ(read->getPacketType(), PacketId::CONNECT_ACKNOWLEDGE);
+    EXPECT_TRUE(read->validate());
+    EXPECT_TRUE(read->getSessionPresent());
+    EXPECT_EQ(read->getReasonCode(), ReasonCode::SUCCESS);
+
+    pool.release(read);
+}
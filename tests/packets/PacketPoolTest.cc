@@ -0,0 +1,192 @@
+/*
+ * File: PacketPoolTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+
+#include "packets/PacketUtility.h"
+#include "mocks/MockClient.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+TEST(PacketPoolTest, Acquire)
+{
+    PacketPool pool;
+
+    Packet *first = pool.acquire(PacketId::PUBLISH_ACKNOWLEDGE);
+    Packet *second = pool.acquire(PacketId::PUBLISH_ACKNOWLEDGE);
+
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first->getPacketType(), PacketId::PUBLISH_ACKNOWLEDGE);
+
+    EXPECT_NE(pool.acquire(PacketId::PUBLISH), first);
+    EXPECT_EQ(pool.acquire(0), nullptr);
+}
+
+TEST(PacketPoolTest, ReadReusesPackets)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    PacketPool pool;
+
+    uint8_t first[] = {
+        0x32,                  // Publish ID with QoS 1
+        0x10,                  // Remaining Length
+        0x00, 0x03,            // Length of topic (Big Endian Ordering)
+        'a', '/', 'b',         // Topic
+        0x34, 0x12,            // Packet Identifier
+        0x00,                  // Properties Length
+        1, 2, 3, 4, 5, 6, 7, 8 // Payload
+    };
+
+    uint8_t second[] = {
+        0x30,          // Publish ID with QoS 0
+        0x07,          // Remaining Length
+        0x00, 0x02,    // Length of topic (Big Endian Ordering)
+        'c', 'd',      // Topic
+        0x00,          // Properties Length
+        9, 10          // Payload
+    };
+
+    client.pushToReadBuffer(first, sizeof(first));
+
+    Publish *publish = (Publish *)readPacketFromClient(clientPtr, pool);
+
+    ASSERT_NE(publish, nullptr);
+    EXPECT_EQ(publish->getQos(), +QoS::ONE);
+    EXPECT_EQ(publish->getPacketIdentifier(), 0x1234);
+    ASSERT_EQ(publish->getPayload().size(), 8);
+
+    uint8_t *buffer = publish->getPayload().getData();
+
+    pool.release(publish);
+
+    client.pushToReadBuffer(second, sizeof(second));
+
+    Publish *next = (Publish *)readPacketFromClient(clientPtr, pool);
+
+    ASSERT_EQ(next, publish);
+    EXPECT_EQ(next->getQos(), +QoS::ZERO);
+    EXPECT_EQ(next->getPacketIdentifier(), 0);
+    ASSERT_EQ(next->getTopic().size(), 4);
+    EXPECT_EQ(memcmp(next->getTopic().data, "cd", 2), 0);
+
+    // The smaller payload is read into the existing buffer
+    ASSERT_EQ(next->getPayload().size(), 2);
+    EXPECT_EQ(next->getPayload().getData(), buffer);
+    EXPECT_EQ(next->getPayload()[0], 9);
+    EXPECT_EQ(next->getPayload()[1], 10);
+
+    pool.release(next);
+}
+
+TEST(PacketPoolTest, LazyPublishProperties)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    PacketPool pool;
+
+    uint8_t data[] = {
+        0x30,                                   // Publish ID with QoS 0
+        0x11,                                   // Remaining Length
+        0x00, 0x01,                             // Length of topic (Big Endian Ordering)
+        't',                                    // Topic
+        0x0B,                                   // Properties Length
+        0x26, 0x00, 0x03, 'k', 'e', 'y', 0x00, 0x03, 'v', 'a', 'l', // User Property
+        'x', 'y'                                // Payload
+    };
+
+    client.pushToReadBuffer(data, sizeof(data));
+
+    Publish *publish = (Publish *)readPacketFromClient(clientPtr, pool);
+
+    ASSERT_NE(publish, nullptr);
+    ASSERT_EQ(publish->getPayload().size(), 2);
+    EXPECT_EQ(publish->getPayload()[0], 'x');
+
+    EncodedString value = publish->getUserProperty("key", 3);
+    ASSERT_EQ(value.size(), 5);
+    EXPECT_EQ(memcmp(value.data, "val", 3), 0);
+
+    pool.release(publish);
+}
+
+TEST(PacketPoolTest, ResetProgress)
+{
+    MockClient client;
+    Client *clientPtr = (Client *)&client;
+    PacketPool pool;
+
+    uint8_t partial[] = {
+        0x40,       // Publish Acknowledge ID
+        0x08,       // Remaining Length
+        0x00, 0x01, // Packet Identifier
+        0x00,       // Reason Code
+        0x04,       // Properties Length
+        0x1F, 0x00  // Reason String, cut short
+    };
+
+    uint8_t data[] = {
+        0x40,                // Publish Acknowledge ID
+        0x08,                // Remaining Length
+        0x00, 0x05,          // Packet Identifier
+        0x10,                // Reason Code
+        0x04,                // Properties Length
+        0x1F, 0x00, 0x01, 'r' // Reason String
+    };
+
+    client.pushToReadBuffer(partial, sizeof(partial));
+
+    EXPECT_EQ(readPacketFromClient(clientPtr, pool), nullptr);
+    EXPECT_NE(pool.getReadProgress().packet, nullptr);
+
+    // The connection is lost half way through the packet
+    pool.resetProgress();
+
+    EXPECT_EQ(pool.getReadProgress().state, 0);
+    EXPECT_EQ(pool.getReadProgress().packet, nullptr);
+
+    // The next connection starts on a packet boundary
+    MockClient next;
+    next.pushToReadBuffer(data, sizeof(data));
+
+    Acknowledge *acknowledge = (Acknowledge *)readPacketFromClient((Client *)&next, pool);
+
+    ASSERT_NE(acknowledge, nullptr);
+    EXPECT_EQ(acknowledge->getReasonCode(), 0x10);
+    EXPECT_EQ(acknowledge->getProperties().length(), 1);
+
+    pool.release(acknowledge);
+}
@@ -0,0 +1,99 @@
+/*
+ * File: PacketTemplatesTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+
+#include "packets/PacketUtility.h"
+#include "packets/PacketTemplates.h"
+#include "PacketBuffer.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+static_assert(PING_REQUEST_TEMPLATE.bytes[0] == 0xC0 && PING_REQUEST_TEMPLATE.size() == 2);
+static_assert(PUBLISH_RELEASE_TEMPLATE.bytes[0] == 0x62 && PUBLISH_RELEASE_TEMPLATE.bytes[1] == 2);
+
+template <size_t N>
+static void expectMatches(Packet &packet, const PacketTemplate<N> &packetTemplate)
+{
+    PacketBuffer buffer(packet.totalSize());
+    packet.push(buffer);
+
+    ASSERT_EQ(buffer.getLength(), N);
+
+    for (size_t i = 0; i < N; i++)
+    {
+        ASSERT_EQ(buffer.getBuffer()[i], packetTemplate.bytes[i]) << "at position " << i;
+    }
+}
+
+TEST(PacketTemplatesTest, Ping)
+{
+    PingRequest request;
+    expectMatches(request, PING_REQUEST_TEMPLATE);
+
+    PingResponse response;
+    expectMatches(response, PING_RESPONSE_TEMPLATE);
+}
+
+TEST(PacketTemplatesTest, Acknowledgements)
+{
+    for (uint16_t identifier : {0x0001, 0x1234, 0xFFFF})
+    {
+        PublishAcknowledge acknowledge;
+        acknowledge.setPacketIdentifier(identifier);
+        expectMatches(acknowledge, withPacketIdentifier(PUBLISH_ACKNOWLEDGE_TEMPLATE, identifier));
+
+        PublishReceived received;
+        received.setPacketIdentifier(identifier);
+        expectMatches(received, withPacketIdentifier(PUBLISH_RECEIVED_TEMPLATE, identifier));
+
+        PublishRelease release;
+        release.setPacketIdentifier(identifier);
+        expectMatches(release, withPacketIdentifier(PUBLISH_RELEASE_TEMPLATE, identifier));
+
+        PublishComplete complete;
+        complete.setPacketIdentifier(identifier);
+        expectMatches(complete, withPacketIdentifier(PUBLISH_COMPLETE_TEMPLATE, identifier));
+    }
+}
+
+TEST(PacketTemplatesTest, Disconnect)
+{
+    Disconnect disconnect;
+    expectMatches(disconnect, DISCONNECT_TEMPLATE);
+
+    disconnect.setReasonCode(ReasonCode::KEEP_ALIVE_TIMEOUT);
+    expectMatches(disconnect, disconnectTemplate(ReasonCode::KEEP_ALIVE_TIMEOUT));
+}
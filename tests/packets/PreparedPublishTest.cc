@@ -0,0 +1,147 @@
+/*
+ * File: PreparedPublishTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+
+#include "packets/Publish.h"
+#include "packets/PreparedPublish.h"
+#include "PacketBuffer.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+TEST(PreparedPublishTest, MatchesPublish)
+{
+    EncodedString topic("my/topic", 8);
+    uint8_t data[] = {1, 2, 3, 4, 5};
+    Payload payload(data, sizeof(data));
+
+    for (QoS qos : {QoS::ZERO, QoS::ONE, QoS::TWO})
+    {
+        for (bool retain : {false, true})
+        {
+            Publish publish;
+            publish.setTopic(topic);
+            publish.setPayload(data, sizeof(data));
+            publish.setQos(qos);
+            publish.setRetain(retain);
+            publish.setPacketIdentifier(0x1234);
+
+            PacketBuffer expected(publish.totalSize());
+            publish.push(expected);
+
+            PreparedPublish prepared(topic, qos, retain);
+
+            ASSERT_EQ(prepared.totalSize(payload), expected.getLength());
+
+            PacketBuffer actual(prepared.totalSize(payload));
+            size_t written = prepared.push(actual, 0x1234, payload);
+
+            ASSERT_EQ(written, expected.getLength());
+
+            for (size_t i = 0; i < written; i++)
+            {
+                ASSERT_EQ(actual.getBuffer()[i], expected.getBuffer()[i]) << "at position " << i;
+            }
+        }
+    }
+}
+
+TEST(PreparedPublishTest, Properties)
+{
+    EncodedString topic("a/b", 3);
+    Payload payload;
+    Properties properties;
+
+    properties.addProperty(new PayloadFormatIndicatorProperty(1));
+    properties.addProperty(new MessageExpiryIntervalProperty(60));
+
+    PreparedPublish prepared(topic, QoS::ONE, false, &properties);
+
+    uint8_t expectedData[] = {
+        0x32,            // Publish ID with QoS 1
+        0x0F,            // Remaining Length
+        0x00, 0x03,      // Length of topic (Big Endian Ordering)
+        'a', '/', 'b',   // Topic
+        0x01, 0x01,      // Packet Identifier
+        0x07,            // Properties Length
+        0x01, 0x01,      // Payload Format Indicator
+        0x02, 0, 0, 0, 60 // Message Expiry Interval
+    };
+
+    PacketBuffer buffer(prepared.totalSize(payload));
+    size_t written = prepared.push(buffer, 0x0101, payload);
+
+    ASSERT_EQ(written, sizeof(expectedData));
+
+    for (size_t i = 0; i < written; i++)
+    {
+        ASSERT_EQ(buffer.getBuffer()[i], expectedData[i]) << "at position " << i;
+    }
+}
+
+TEST(PreparedPublishTest, AddedExpiry)
+{
+    EncodedString topic("a", 1);
+    Payload payload;
+    Properties properties;
+
+    properties.addProperty(new PayloadFormatIndicatorProperty(0));
+
+    PreparedPublish prepared(topic, QoS::ZERO, false, &properties);
+
+    ASSERT_EQ(prepared.getMessageExpiry(), 0);
+
+    uint8_t expectedData[] = {
+        0x30,              // Publish ID with QoS 0
+        0x0B,              // Remaining Length
+        0x00, 0x01,        // Length of topic (Big Endian Ordering)
+        'a',               // Topic
+        0x07,              // Properties Length
+        0x02, 0, 0, 0, 30, // Message Expiry Interval
+        0x01, 0x00         // Payload Format Indicator
+    };
+
+    size_t valueOffset = 0;
+    PacketBuffer buffer(prepared.totalSize(payload, 30));
+    size_t written = prepared.push(buffer, 0, payload, 30, valueOffset);
+
+    ASSERT_EQ(written, sizeof(expectedData));
+    ASSERT_EQ(prepared.totalSize(payload, 30), sizeof(expectedData));
+    ASSERT_EQ(valueOffset, 7);
+
+    for (size_t i = 0; i < written; i++)
+    {
+        ASSERT_EQ(buffer.getBuffer()[i], expectedData[i]) << "at position " << i;
+    }
+}
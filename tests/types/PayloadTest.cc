@@ -0,0 +1,96 @@
+/*
+ * File: PayloadTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+
+#include "types/Payload.h"
+#include "PacketBuffer.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+TEST(PayloadTest, Move)
+{
+    uint8_t data[] = {1, 2, 3, 4};
+    Payload source(data, sizeof(data));
+    uint8_t *buffer = source.getData();
+
+    Payload moved(std::move(source));
+
+    ASSERT_EQ(moved.getData(), buffer);
+    ASSERT_EQ(moved.size(), sizeof(data));
+    ASSERT_EQ(source.getData(), nullptr);
+    ASSERT_EQ(source.size(), 0);
+
+    Payload assigned;
+    assigned = std::move(moved);
+
+    ASSERT_EQ(assigned.getData(), buffer);
+    ASSERT_EQ(moved.getData(), nullptr);
+}
+
+TEST(PayloadTest, Release)
+{
+    uint8_t data[] = {1, 2, 3, 4};
+    int released = 0;
+
+    {
+        Payload payload(data, sizeof(data), [&released, &data](uint8_t *buffer, uint32_t length)
+                        {
+                            ASSERT_EQ(buffer, data);
+                            ASSERT_EQ(length, sizeof(data));
+                            released++; });
+
+        ASSERT_EQ(payload.getData(), data);
+
+        Payload moved(std::move(payload));
+
+        ASSERT_EQ(released, 0);
+
+        // Copies own their own buffer and never invoke the release callback
+        Payload copy(moved);
+        ASSERT_NE(copy.getData(), data);
+    }
+
+    ASSERT_EQ(released, 1);
+}
+
+TEST(PayloadTest, WrapIsNotFreed)
+{
+    uint8_t data[] = {1, 2, 3, 4};
+
+    Payload payload = Payload::wrap(data, sizeof(data));
+    payload = Payload(data, sizeof(data));
+
+    ASSERT_NE(payload.getData(), data);
+}
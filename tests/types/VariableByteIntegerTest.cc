@@ -73,4 +73,68 @@ TEST_P(VariableByteIntegerTest, EncodeDecode)
 
 INSTANTIATE_TEST_CASE_P(AllCombinations,
                         VariableByteIntegerTest,
-                        ::testing::ValuesIn(variableTestSet));
\ No newline at end of file
+                        ::testing::ValuesIn(variableTestSet));
+
+TEST(VariableByteIntegerCodecTest, RoundTrip)
+{
+    uint8_t buffer[4];
+
+    // Every representable value
+    for (uint32_t value = 0; value <= VARIABLE_BYTE_INTEGER_MAX; value++)
+    {
+        size_t length = VariableByteInteger::encode(value, buffer);
+        uint32_t decoded = 0;
+
+        // Checked without gtest macros in the loop to keep the 2^28 iterations quick
+        if (length != VariableByteInteger::encodedSize(value) ||
+            VariableByteInteger::decode(buffer, length, decoded) != length ||
+            decoded != value)
+        {
+            FAIL() << "Round trip failed for " << value;
+        }
+    }
+}
+
+TEST(VariableByteIntegerCodecTest, MatchesClientCodec)
+{
+    for (uint32_t value : {0u, 127u, 128u, 16383u, 16384u, 2097151u, 2097152u, 268435455u})
+    {
+        uint8_t buffer[4];
+        size_t length = VariableByteInteger::encode(value, buffer);
+
+        VariableByteInteger integer(value);
+        PacketBuffer packetBuffer(integer.size());
+        ASSERT_EQ(integer.push(packetBuffer), length);
+
+        for (size_t i = 0; i < length; i++)
+        {
+            ASSERT_EQ(packetBuffer.getBuffer()[i], buffer[i]) << "at position " << i;
+        }
+
+        MockClient client;
+        Client *clientPtr = (Client *)&client;
+        VariableByteInteger decoded;
+        uint32_t read = 0;
+
+        client.pushToReadBuffer(buffer, length);
+
+        ASSERT_FALSE(decoded.readFromClient(clientPtr, read));
+        ASSERT_EQ(read, length);
+        ASSERT_EQ(decoded.value, value);
+    }
+}
+
+TEST(VariableByteIntegerCodecTest, Incomplete)
+{
+    uint8_t partial[] = {0x80, 0x80};
+    uint8_t malformed[] = {0x80, 0x80, 0x80, 0x80, 0x01};
+    uint8_t trailing[] = {0x05, 0x80, 0x80};
+    uint32_t value = 0;
+
+    EXPECT_EQ(VariableByteInteger::decode(partial, sizeof(partial), value), 0);
+    EXPECT_EQ(VariableByteInteger::decode(malformed, sizeof(malformed), value), 0);
+    EXPECT_EQ(VariableByteInteger::decode(partial, 0, value), 0);
+
+    ASSERT_EQ(VariableByteInteger::decode(trailing, sizeof(trailing), value), 1);
+    EXPECT_EQ(value, 5);
+}
@@ -42,4 +42,47 @@ namespace CppMqtt
         unsubscribeResult[token] = reasonCodes;
     }
 
+    void MqttViewTestHandler::onConnectionSuccess()
+    {
+        connectionResult = 0;
+    }
+
+    void MqttViewTestHandler::onConnectionFailure(int reasonCode)
+    {
+        connectionResult = reasonCode;
+    }
+
+    void MqttViewTestHandler::onDisconnection(ReasonCode reasonCode)
+    {
+        disconnectionResult = reasonCode._to_integral();
+    }
+
+    void MqttViewTestHandler::onMessage(string_view topic, span<const uint8_t> payload, const MessageMetadata &metadata)
+    {
+        topicQueue.push(string(topic));
+        payloadQueue.push(vector<uint8_t>(payload.begin(), payload.end()));
+        metadataQueue.push({metadata.qos._to_integral(), metadata.retain, metadata.duplicate, metadata.token,
+                            metadata.properties->has(MESSAGE_EXPIRY_INTERVAL)});
+    }
+
+    void MqttViewTestHandler::onDeliveryComplete(Token token)
+    {
+        deliveryQueue.push(token);
+    }
+
+    void MqttViewTestHandler::onDeliveryFailure(Token token, int reasonCode)
+    {
+        deliveryFailureQueue.push({token, reasonCode});
+    }
+
+    void MqttViewTestHandler::onSubscribeResult(Token token, span<const uint8_t> reasonCodes)
+    {
+        subscribeResult[token] = vector<uint8_t>(reasonCodes.begin(), reasonCodes.end());
+    }
+
+    void MqttViewTestHandler::onUnsubscribeResult(Token token, span<const uint8_t> reasonCodes)
+    {
+        unsubscribeResult[token] = vector<uint8_t>(reasonCodes.begin(), reasonCodes.end());
+    }
+
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <queue>
 #include <tuple>
 #include <map>
+#include <string>
 
 namespace CppMqtt
 {
@@ -30,6 +31,29 @@ namespace CppMqtt
         virtual void onSubscribeResult(Token token, vector<uint8_t> reasonCodes) override;
         virtual void onUnsubscribeResult(Token token, vector<uint8_t> reasonCodes) override;
     };
+
+    class MqttViewTestHandler : MqttClientHandlerV2
+    {
+    public:
+        int connectionResult = -1;
+        int disconnectionResult = -1;
+        map<Token, vector<uint8_t>> subscribeResult;
+        map<Token, vector<uint8_t>> unsubscribeResult;
+        queue<string> topicQueue;
+        queue<vector<uint8_t>> payloadQueue;
+        queue<tuple<uint8_t, bool, bool, Token, bool>> metadataQueue;
+        queue<Token> deliveryQueue;
+        queue<tuple<Token, uint8_t>> deliveryFailureQueue;
+
+        virtual void onConnectionSuccess() override;
+        virtual void onConnectionFailure(int reasonCode) override;
+        virtual void onDisconnection(ReasonCode reasonCode) override;
+        virtual void onMessage(string_view topic, span<const uint8_t> payload, const MessageMetadata &metadata) override;
+        virtual void onDeliveryComplete(Token token) override;
+        virtual void onDeliveryFailure(Token token, int reasonCode) override;
+        virtual void onSubscribeResult(Token token, span<const uint8_t> reasonCodes) override;
+        virtual void onUnsubscribeResult(Token token, span<const uint8_t> reasonCodes) override;
+    };
 }
 
 #endif /* MQTTTESTCLIENT */
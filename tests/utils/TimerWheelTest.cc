@@ -0,0 +1,199 @@
+/*
+ * File: TimerWheelTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "stdint.h"
+
+#include "utils/TimerWheel.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+TEST(TimerWheelTest, ExpiresOnDeadline)
+{
+    TimerWheel wheel;
+    vector<uint64_t> fired;
+    uint32_t delays[] = {0, 1, 63, 64, 65, 4095, 4096, 70000, 300000, 20000000};
+    vector<Timer *> timers;
+
+    for (uint32_t delay : delays)
+    {
+        Timer *timer = new Timer([&fired, &wheel]() { fired.push_back(wheel.getTime()); });
+        wheel.schedule(*timer, delay);
+        timers.push_back(timer);
+    }
+
+    ASSERT_EQ(wheel.size(), 10);
+
+    // One tick at a time up to the furthest level
+    for (uint64_t tick = 0; tick < 300000; tick++)
+    {
+        wheel.advance(1);
+    }
+
+    // Beyond the last level, the timer is placed again each time that level turns
+    wheel.advance(20000000 - 300000 - 1);
+    ASSERT_EQ(wheel.size(), 1);
+    wheel.advance(1);
+
+    ASSERT_EQ(wheel.size(), 0);
+    ASSERT_EQ(fired, vector<uint64_t>({1, 1, 63, 64, 65, 4095, 4096, 70000, 300000, 20000000}));
+
+    for (Timer *timer : timers)
+    {
+        delete timer;
+    }
+}
+
+TEST(TimerWheelTest, MatchesSortedDeadlines)
+{
+    TimerWheel wheel;
+    mt19937 random(7);
+    vector<uint64_t> expected;
+    vector<uint64_t> fired;
+    Timer timers[512];
+
+    for (Timer &timer : timers)
+    {
+        uint32_t delay = random() % 200000;
+        timer.setCallback([&fired, &timer]() { fired.push_back(timer.getDeadline()); });
+        wheel.schedule(timer, delay);
+        expected.push_back(delay);
+    }
+
+    sort(expected.begin(), expected.end());
+
+    while (wheel.size() > 0)
+    {
+        wheel.advance(1 + random() % 50);
+    }
+
+    // Timers expiring on the same advance fire in deadline order
+    ASSERT_EQ(fired, expected);
+}
+
+TEST(TimerWheelTest, CallbacksRunAfterAdvancing)
+{
+    TimerWheel wheel;
+    uint64_t rescheduledAt = 0;
+    Timer cancelled([]() { FAIL(); });
+    Timer repeating;
+
+    repeating.setCallback([&]() {
+        rescheduledAt = wheel.getTime();
+        cancelled.cancel();
+        wheel.schedule(repeating, 10);
+    });
+
+    wheel.schedule(repeating, 5);
+    wheel.schedule(cancelled, 8);
+
+    // Both expire within the step, the first cancels the second
+    wheel.advance(100);
+
+    ASSERT_EQ(rescheduledAt, 100);
+    ASSERT_FALSE(cancelled.scheduled());
+    ASSERT_TRUE(repeating.scheduled());
+    ASSERT_EQ(repeating.getDeadline(), 110);
+
+    repeating.cancel();
+    ASSERT_EQ(wheel.size(), 0);
+
+    // Rescheduling moves the deadline rather than adding another
+    wheel.schedule(cancelled, 10);
+    wheel.schedule(cancelled, 20);
+    ASSERT_EQ(wheel.size(), 1);
+    cancelled.cancel();
+}
+
+TEST(TimerWheelTest, CallbackDestroysTimer)
+{
+    TimerWheel wheel;
+    vector<int> fired;
+    Timer *timer = new Timer();
+    int value = 7;
+
+    // Captures enough state that the closure is destroyed along with the timer
+    timer->setCallback([&fired, &timer, value]() {
+        delete timer;
+        timer = NULL;
+        fired.push_back(value);
+    });
+
+    wheel.schedule(*timer, 5);
+    wheel.advance(10);
+
+    ASSERT_EQ(timer, nullptr);
+    ASSERT_EQ(fired, vector<int>({7}));
+    ASSERT_EQ(wheel.size(), 0);
+}
+
+TEST(TimerWheelTest, NextExpiry)
+{
+    TimerWheel wheel;
+    mt19937 random(11);
+    Timer timers[256];
+
+    ASSERT_EQ(wheel.nextExpiry(), -1);
+
+    wheel.schedule(timers[0], 0);
+    ASSERT_EQ(wheel.nextExpiry(), 1);
+    timers[0].cancel();
+
+    // Spread across every level, then compared against the earliest deadline as time moves
+    for (Timer &timer : timers)
+    {
+        wheel.schedule(timer, random() % 20000000);
+    }
+
+    while (wheel.size() > 0)
+    {
+        uint64_t earliest = UINT64_MAX;
+
+        for (Timer &timer : timers)
+        {
+            if (timer.scheduled())
+            {
+                earliest = min(earliest, timer.getDeadline());
+            }
+        }
+
+        ASSERT_EQ(wheel.nextExpiry(), (int64_t)(earliest - wheel.getTime())) << "at " << wheel.getTime();
+
+        wheel.advance(wheel.nextExpiry());
+    }
+
+    ASSERT_EQ(wheel.nextExpiry(), -1);
+}
@@ -0,0 +1,142 @@
+/*
+ * File: TopicTest.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+#include <string>
+
+#include "utils/Topic.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+typedef struct
+{
+    string topic;
+    bool validName;
+    bool validFilter;
+} TopicTestSet;
+
+static const TopicTestSet topicTestSet[] = {
+    {"sport/tennis/player1", true, true},
+    {"/", true, true},
+    {"a//b", true, true},
+    {"/finance", true, true},
+    {"$SYS/uptime", true, true},
+    {"", false, false},
+    {"#", false, true},
+    {"+", false, true},
+    {"sport/#", false, true},
+    {"sport/+/player1", false, true},
+    {"+/+", false, true},
+    {"/+", false, true},
+    {"sport+", false, false},
+    {"sport/tennis#", false, false},
+    {"sport/#/ranking", false, false},
+    {"sport/++", false, false},
+    {"$share/group/sport/#", false, true},
+    {"$share/group/+", false, true},
+    {"$share//sport", true, false},
+    {"$share/group", true, false},
+    {"$share/group/", true, false},
+    {"$share/gr+up/sport", false, false},
+    {string("a\0b", 3), false, false},
+    {"caf\xC3\xA9/menu", true, true},
+    {"bad\xC3/menu", false, false},
+};
+
+class TopicTest : public ::testing::TestWithParam<TopicTestSet>
+{
+};
+
+TEST_P(TopicTest, Validate)
+{
+    TopicTestSet testData = GetParam();
+
+    EXPECT_EQ(isValidTopicName(testData.topic.data(), testData.topic.size()), testData.validName) << testData.topic;
+    EXPECT_EQ(isValidTopicFilter(testData.topic.data(), testData.topic.size()), testData.validFilter) << testData.topic;
+}
+
+INSTANTIATE_TEST_CASE_P(AllCombinations,
+                        TopicTest,
+                        ::testing::ValuesIn(topicTestSet));
+
+typedef struct
+{
+    string filter;
+    string topic;
+    bool matches;
+} TopicMatchTestSet;
+
+static const TopicMatchTestSet topicMatchTestSet[] = {
+    {"sport/tennis/player1", "sport/tennis/player1", true},
+    {"sport/tennis/player1", "sport/tennis/player2", false},
+    {"sport/tennis/player1", "sport/tennis", false},
+    {"sport/tennis", "sport/tennis/player1", false},
+    {"sport/#", "sport", true},
+    {"sport/#", "sport/tennis/player1", true},
+    {"sport/tennis/#", "sport/tennis", true},
+    {"sport/tennis/#", "sport/tennisplayer", false},
+    {"#", "sport/tennis", true},
+    {"#", "/", true},
+    {"sport/+", "sport/tennis", true},
+    {"sport/+", "sport/", true},
+    {"sport/+", "sport", false},
+    {"sport/+", "sport/tennis/player1", false},
+    {"+/+", "/finance", true},
+    {"/+", "/finance", true},
+    {"+", "/finance", false},
+    {"+/tennis/#", "sport/tennis/player1", true},
+    {"#", "$SYS/uptime", false},
+    {"+/uptime", "$SYS/uptime", false},
+    {"$SYS/#", "$SYS/uptime", true},
+    {"$share/group/sport/+", "sport/tennis", true},
+    {"$share/group/sport/+", "group/sport", false},
+};
+
+class TopicMatchTest : public ::testing::TestWithParam<TopicMatchTestSet>
+{
+};
+
+TEST_P(TopicMatchTest, Match)
+{
+    TopicMatchTestSet testData = GetParam();
+
+    EXPECT_EQ(topicMatchesFilter(testData.filter.data(), testData.filter.size(), testData.topic.data(), testData.topic.size()),
+              testData.matches)
+        << testData.filter << " " << testData.topic;
+}
+
+INSTANTIATE_TEST_CASE_P(AllCombinations,
+                        TopicMatchTest,
+                        ::testing::ValuesIn(topicMatchTestSet));
@@ -0,0 +1,99 @@
+/*
+ * File: Utf8Test.cc
+ * Project: cpp_mqtt_client
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+
+
+#include "gtest/gtest.h"
+#include "stdint.h"
+#include <string>
+
+#include "utils/Utf8.h"
+
+using namespace std;
+using namespace CppMqtt;
+
+typedef struct
+{
+    string data;
+    bool valid;
+} Utf8TestSet;
+
+static const Utf8TestSet utf8TestSet[] = {
+    {"", true},
+    {"sensors/temperature", true},
+    {"caf\xC3\xA9", true},                 // U+00E9
+    {"\xE2\x82\xAC", true},                // U+20AC
+    {"\xF0\x9F\x98\x80", true},            // U+1F600
+    {"\xEF\xBF\xBF", true},                // U+FFFF
+    {"\xF4\x8F\xBF\xBF", true},            // U+10FFFF
+    {"\x80", false},                       // Lone continuation byte
+    {"\xC0\xAF", false},                   // Overlong encoding
+    {"\xE0\x80\xAF", false},               // Overlong encoding
+    {"\xF0\x80\x80\xAF", false},           // Overlong encoding
+    {"\xED\xA0\x80", false},               // Surrogate U+D800
+    {"\xF4\x90\x80\x80", false},           // Above U+10FFFF
+    {"\xF5\x80\x80\x80", false},           // Invalid lead byte
+    {"\xC3", false},                       // Truncated
+    {"\xE2\x82", false},                   // Truncated
+    {"\xE2\x28\xA1", false},               // Invalid continuation
+};
+
+class Utf8Test : public ::testing::TestWithParam<Utf8TestSet>
+{
+};
+
+TEST_P(Utf8Test, Validate)
+{
+    Utf8TestSet testData = GetParam();
+
+    // Checked on its own and at every offset around the block sizes used by the fast path
+    for (size_t prefix : {0, 1, 7, 8, 15, 16, 31, 32, 33, 64})
+    {
+        string data = string(prefix, 'a') + testData.data + string(prefix, 'b');
+        EXPECT_EQ(isValidUtf8((const uint8_t *)data.data(), data.size()), testData.valid) << "with prefix " << prefix;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(AllCombinations,
+                        Utf8Test,
+                        ::testing::ValuesIn(utf8TestSet));
+
+TEST(Utf8NullTest, Null)
+{
+    for (size_t position : {0, 5, 16, 40, 63})
+    {
+        string data(64, 'x');
+        data[position] = '\0';
+
+        EXPECT_TRUE(isValidUtf8((const uint8_t *)data.data(), data.size(), true));
+        EXPECT_FALSE(isValidUtf8((const uint8_t *)data.data(), data.size(), false)) << "at position " << position;
+    }
+}